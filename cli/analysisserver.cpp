@@ -0,0 +1,338 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "analysisserver.h"
+
+#if !defined(WIN32) && !defined(__MINGW32__)
+
+#include "color.h"
+#include "cppcheck.h"
+#include "errorlogger.h"
+#include "errortypes.h"
+#include "filesettings.h"
+#include "path.h"
+#include "settings.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <utility>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+#if defined(MSG_NOSIGNAL)
+    constexpr int sendFlags = MSG_NOSIGNAL;
+#else
+    constexpr int sendFlags = 0;
+#endif
+
+    /** Closes the file descriptor when going out of scope */
+    class ScopedFd {
+    public:
+        explicit ScopedFd(int fd) : mFd(fd) {}
+        ~ScopedFd() {
+            if (mFd >= 0)
+                close(mFd);
+        }
+        ScopedFd(const ScopedFd &) = delete;
+        ScopedFd& operator=(const ScopedFd &) = delete;
+
+        int get() const {
+            return mFd;
+        }
+
+    private:
+        const int mFd;
+    };
+
+    bool writeAll(int fd, const char *data, std::size_t len)
+    {
+        while (len > 0) {
+            const ssize_t written = send(fd, data, len, sendFlags);
+            if (written < 0) {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            data += written;
+            len -= written;
+        }
+        return true;
+    }
+
+    bool readAll(int fd, char *data, std::size_t len)
+    {
+        while (len > 0) {
+            const ssize_t bytesRead = read(fd, data, len);
+            if (bytesRead < 0 && errno == EINTR)
+                continue;
+            if (bytesRead <= 0)
+                return false;
+            data += bytesRead;
+            len -= bytesRead;
+        }
+        return true;
+    }
+
+    bool writeMessage(int fd, AnalysisServer::MessageType type, const std::string &data)
+    {
+        const auto t = static_cast<char>(type);
+        const auto len = static_cast<unsigned int>(data.length());
+        return writeAll(fd, &t, 1) &&
+               writeAll(fd, reinterpret_cast<const char*>(&len), sizeof(len)) &&
+               writeAll(fd, data.data(), len);
+    }
+
+    bool readMessage(int fd, char &type, std::string &data)
+    {
+        unsigned int len = 0;
+        if (!readAll(fd, &type, 1) || !readAll(fd, reinterpret_cast<char*>(&len), sizeof(len)))
+            return false;
+        data.resize(len);
+        return len == 0 || readAll(fd, &data[0], len);
+    }
+
+    bool makeAddress(const std::string &socketPath, sockaddr_un &addr)
+    {
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (socketPath.empty() || socketPath.size() >= sizeof(addr.sun_path))
+            return false;
+        std::memcpy(addr.sun_path, socketPath.c_str(), socketPath.size());
+        return true;
+    }
+
+    /** The path as the server sees it. Unsaved files do not exist yet so they are not resolved. */
+    std::string absolutePath(const std::string &path)
+    {
+        std::string absolute = Path::getAbsoluteFilePath(path);
+        if (absolute.empty())
+            absolute = Path::isAbsolute(path) ? path : Path::join(Path::getCurrentPath(), path);
+        return absolute;
+    }
+
+    int connectTo(const std::string &socketPath)
+    {
+        sockaddr_un addr;
+        if (!makeAddress(socketPath, addr))
+            return -1;
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+            return -1;
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    /** Forwards the reports of a check to the client */
+    class SocketWriter : public ErrorLogger {
+    public:
+        explicit SocketWriter(int fd) : mFd(fd) {}
+
+        void reportOut(const std::string &outmsg, Color c) override {
+            write(AnalysisServer::REPORT_OUT, static_cast<char>(c) + outmsg);
+        }
+
+        void reportErr(const ErrorMessage &msg) override {
+            write(AnalysisServer::REPORT_ERROR, msg.serialize());
+        }
+
+        bool write(AnalysisServer::MessageType type, const std::string &data) {
+            // once the client is gone there is nobody to report to
+            mFailed = mFailed || !writeMessage(mFd, type, data);
+            return !mFailed;
+        }
+
+    private:
+        const int mFd;
+        bool mFailed{};
+    };
+
+    /** Send one request and pass the reports to the logger. @return the result or -1 on failure */
+    int request(int fd, AnalysisServer::MessageType type, const std::string &data, ErrorLogger &errorLogger, bool quiet)
+    {
+        if (!writeMessage(fd, type, data))
+            return -1;
+
+        char t = 0;
+        std::string buf;
+        while (readMessage(fd, t, buf)) {
+            if (t == AnalysisServer::REPORT_OUT && !buf.empty()) {
+                if (!quiet)
+                    errorLogger.reportOut(buf.substr(1), static_cast<Color>(buf[0]));
+            } else if (t == AnalysisServer::REPORT_ERROR) {
+                ErrorMessage msg;
+                try {
+                    msg.deserialize(buf);
+                } catch (const InternalError &) {
+                    return -1;
+                }
+                errorLogger.reportErr(msg);
+            } else if (t == AnalysisServer::CHECK_END) {
+                return std::stoi(buf);
+            } else {
+                return -1;
+            }
+        }
+        return -1;
+    }
+}
+
+AnalysisServer::AnalysisServer(const Settings &settings, const std::list<FileSettings> &fileSettings, ErrorLogger &errorLogger, CppCheck::ExecuteCmdFn executeCommand)
+    : mSettings(settings)
+    , mErrorLogger(errorLogger)
+    , mExecuteCommand(std::move(executeCommand))
+{
+    for (const FileSettings &fs : fileSettings)
+        mFileSettings.emplace(Path::getAbsoluteFilePath(fs.filename()), &fs);
+}
+
+bool AnalysisServer::run(const std::string &socketPath)
+{
+    sockaddr_un addr;
+    if (!makeAddress(socketPath, addr)) {
+        mErrorLogger.reportOut("cppcheck: error: invalid socket path '" + socketPath + "'.");
+        return false;
+    }
+
+    const ScopedFd listener(socket(AF_UNIX, SOCK_STREAM, 0));
+    if (listener.get() < 0) {
+        mErrorLogger.reportOut(std::string("cppcheck: error: could not create socket: ") + std::strerror(errno));
+        return false;
+    }
+
+    // remove the socket of a server that did not shut down cleanly but never any other file
+    struct stat st;
+    if (lstat(socketPath.c_str(), &st) == 0 && S_ISSOCK(st.st_mode))
+        unlink(socketPath.c_str());
+
+    if (bind(listener.get(), reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listener.get(), 16) != 0) {
+        mErrorLogger.reportOut("cppcheck: error: could not listen on '" + socketPath + "': " + std::strerror(errno));
+        return false;
+    }
+
+    bool running = true;
+    while (running && !Settings::terminated()) {
+        const int fd = accept(listener.get(), nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            mErrorLogger.reportOut(std::string("cppcheck: error: accept failed: ") + std::strerror(errno));
+            break;
+        }
+        const ScopedFd connection(fd);
+#if defined(SO_NOSIGPIPE)
+        const int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+        running = serve(fd);
+    }
+
+    unlink(socketPath.c_str());
+    return true;
+}
+
+bool AnalysisServer::serve(int fd)
+{
+    SocketWriter writer(fd);
+
+    // every client gets a fresh instance so results and suppression state of earlier clients do not leak
+    CppCheck cppcheck(writer, true, mExecuteCommand);
+    cppcheck.settings() = mSettings; // this is a copy
+
+    bool running = true;
+    char type = 0;
+    std::string data;
+    while (readMessage(fd, type, data)) {
+        if (type == SHUTDOWN) {
+            running = false;
+            continue;
+        }
+        if (type != CHECK_FILE && type != CHECK_CONTENT)
+            break;
+
+        const std::string::size_type sep = (type == CHECK_CONTENT) ? data.find('\0') : std::string::npos;
+        if (type == CHECK_CONTENT && sep == std::string::npos)
+            break;
+        const std::string path = data.substr(0, sep);
+
+        unsigned int result = 0;
+        try {
+            if (type == CHECK_CONTENT) {
+                result = cppcheck.check(FileWithDetails(path), data.substr(sep + 1));
+            } else {
+                const auto it = mFileSettings.find(path);
+                if (it != mFileSettings.end())
+                    result = cppcheck.check(*it->second);
+                else
+                    result = cppcheck.check(FileWithDetails(path));
+            }
+        } catch (const std::exception &e) {
+            writer.reportOut(std::string("cppcheck: error: ") + e.what(), Color::Reset);
+            result = 1;
+        }
+
+        if (!writer.write(CHECK_END, std::to_string(result)))
+            break;
+    }
+    return running;
+}
+
+int AnalysisServer::check(const std::string &socketPath, const std::list<FileWithDetails> &files, ErrorLogger &errorLogger, bool quiet)
+{
+    const ScopedFd fd(connectTo(socketPath));
+    if (fd.get() < 0)
+        return -1;
+
+    int result = 0;
+    for (const FileWithDetails &file : files) {
+        const int res = request(fd.get(), CHECK_FILE, absolutePath(file.path()), errorLogger, quiet);
+        if (res < 0)
+            return -1;
+        result += res;
+    }
+    return result;
+}
+
+int AnalysisServer::check(const std::string &socketPath, const FileWithDetails &file, const std::string &content, ErrorLogger &errorLogger)
+{
+    const ScopedFd fd(connectTo(socketPath));
+    if (fd.get() < 0)
+        return -1;
+
+    std::string data = absolutePath(file.path());
+    data += '\0';
+    data += content;
+    return request(fd.get(), CHECK_CONTENT, data, errorLogger, false);
+}
+
+bool AnalysisServer::shutdown(const std::string &socketPath)
+{
+    const ScopedFd fd(connectTo(socketPath));
+    return fd.get() >= 0 && writeMessage(fd.get(), SHUTDOWN, emptyString);
+}
+
+#endif // !WIN32
@@ -0,0 +1,110 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ANALYSISSERVER_H
+#define ANALYSISSERVER_H
+
+#include "cppcheck.h"
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+class Settings;
+class ErrorLogger;
+struct FileSettings;
+class FileWithDetails;
+
+/// @addtogroup CLI
+/// @{
+
+/**
+ * Persistent analysis mode (--server=<socket>).
+ *
+ * The server keeps the settings with the loaded libraries and addons and
+ * the imported project resident and checks files on request of clients
+ * which connect through a Unix domain socket. This avoids the startup
+ * cost of the command line tool when only a few files are checked.
+ *
+ * Every message in both directions consists of a type byte, the length
+ * of the payload as unsigned int and the payload. A client sends one
+ * request and reads the reports until CHECK_END before it sends the next
+ * one.
+ *
+ * Requests:
+ *  - CHECK_FILE: the absolute path of the file to check
+ *  - CHECK_CONTENT: the absolute path, a '\\0' and the code to check
+ *    instead of the file content
+ *  - SHUTDOWN: stop the server once the connection is closed
+ *
+ * Responses:
+ *  - REPORT_OUT: the color followed by the text
+ *  - REPORT_ERROR: a serialized ErrorMessage
+ *  - CHECK_END: the result of the check as decimal number
+ */
+class AnalysisServer {
+public:
+    enum MessageType : std::uint8_t { CHECK_FILE='f', CHECK_CONTENT='c', SHUTDOWN='q', REPORT_OUT='1', REPORT_ERROR='2', CHECK_END='5' };
+
+    AnalysisServer(const Settings &settings, const std::list<FileSettings> &fileSettings, ErrorLogger &errorLogger, CppCheck::ExecuteCmdFn executeCommand);
+    AnalysisServer(const AnalysisServer &) = delete;
+    AnalysisServer& operator=(const AnalysisServer &) = delete;
+
+    /**
+     * Listen on the socket and serve clients until a SHUTDOWN request
+     * is received or the process is terminated.
+     * @return false if the socket could not be set up
+     */
+    bool run(const std::string &socketPath);
+
+    /**
+     * Ask the server listening on the socket to check files and pass the
+     * reports to the logger. With quiet the progress output is dropped.
+     * @return the sum of the results or -1 if the server could not be reached
+     */
+    static int check(const std::string &socketPath, const std::list<FileWithDetails> &files, ErrorLogger &errorLogger, bool quiet = false);
+
+    /**
+     * Ask the server listening on the socket to check the given code as
+     * content of the file and pass the reports to the logger.
+     * @return the result or -1 if the server could not be reached
+     */
+    static int check(const std::string &socketPath, const FileWithDetails &file, const std::string &content, ErrorLogger &errorLogger);
+
+    /**
+     * Ask the server listening on the socket to stop.
+     * @return false if the server could not be reached
+     */
+    static bool shutdown(const std::string &socketPath);
+
+private:
+    /** Serve the requests of a connected client. @return false if the server shall stop */
+    bool serve(int fd);
+
+    const Settings &mSettings;
+    ErrorLogger &mErrorLogger;
+    CppCheck::ExecuteCmdFn mExecuteCommand;
+
+    /** project files by their absolute path */
+    std::unordered_map<std::string, const FileSettings*> mFileSettings;
+};
+
+/// @}
+
+#endif // ANALYSISSERVER_H
@@ -30,6 +30,7 @@
 #include "filesettings.h"
 #include "importproject.h"
 #include "library.h"
+#include "memoryusage.h"
 #include "path.h"
 #include "pathmatch.h"
 #include "platform.h"
@@ -156,12 +157,14 @@ bool CmdLineParser::fillSettingsFromArgs(int argc, const char* const argv[])
     }
 
     // Libraries must be loaded before FileLister is executed to ensure markup files will be
-    // listed properly.
-    if (!loadLibraries(mSettings))
-        return false;
+    // listed properly. A client leaves the analysis to the server which has them loaded already.
+    if (mSettings.clientSocket.empty()) {
+        if (!loadLibraries(mSettings))
+            return false;
 
-    if (!loadAddons(mSettings))
-        return false;
+        if (!loadAddons(mSettings))
+            return false;
+    }
 
     // Check that all include paths exist
     {
@@ -215,6 +218,16 @@ bool CmdLineParser::fillSettingsFromArgs(int argc, const char* const argv[])
             fileSettings = fileSettingsRef;
         }
 
+        if (!mSettings.diff.empty()) {
+            fileSettings.remove_if([&](const FileSettings &fs) {
+                return !mSettings.diff.hasFile(fs.filename());
+            });
+            if (fileSettings.empty()) {
+                mLogger.printError("could not find any files of the diff.");
+                return false;
+            }
+        }
+
         mFileSettings.clear();
 
         // sort the markup last
@@ -287,6 +300,16 @@ bool CmdLineParser::fillSettingsFromArgs(int argc, const char* const argv[])
             files = std::move(filesResolved);
         }
 
+        if (!mSettings.diff.empty()) {
+            files.remove_if([&](const FileWithDetails& entry) {
+                return !mSettings.diff.hasFile(entry.path());
+            });
+            if (files.empty()) {
+                mLogger.printError("could not find any files of the diff.");
+                return false;
+            }
+        }
+
         // sort the markup last
         std::copy_if(files.cbegin(), files.cend(), std::inserter(mFiles, mFiles.end()), [&](const FileWithDetails& entry) {
             return !mSettings.library.markupFile(entry.path()) || !mSettings.library.processMarkupAfterCode(entry.path());
@@ -520,6 +543,20 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
                 mSettings.clangExecutable = argv[i] + 8;
             }
 
+            // Let a running analysis server check the files
+            else if (std::strncmp(argv[i], "--client=", 9) == 0) {
+#if !defined(WIN32) && !defined(__MINGW32__)
+                mSettings.clientSocket = argv[i] + 9;
+                if (mSettings.clientSocket.empty()) {
+                    mLogger.printError("no socket specified for '--client'.");
+                    return Result::Fail;
+                }
+#else
+                mLogger.printError("Option --client is not supported on this platform.");
+                return Result::Fail;
+#endif
+            }
+
             else if (std::strncmp(argv[i], "--config-exclude=",17) ==0) {
                 mSettings.configExcludePaths.insert(Path::fromNativeSeparators(argv[i] + 17));
             }
@@ -569,6 +606,30 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
             else if (std::strcmp(argv[i], "--debug-warnings") == 0)
                 mSettings.debugwarnings = true;
 
+            // Check only the functions changed by a diff
+            else if (std::strncmp(argv[i], "--diff=", 7) == 0) {
+                const std::string filename = argv[i] + 7;
+                std::string errmsg;
+                if (filename == "-") {
+                    errmsg = mSettings.diff.parseDiff(std::cin);
+                } else {
+                    std::ifstream f(filename);
+                    if (!f.is_open()) {
+                        mLogger.printError("couldn't open the file: \"" + filename + "\".");
+                        return Result::Fail;
+                    }
+                    errmsg = mSettings.diff.parseDiff(f);
+                }
+                if (!errmsg.empty()) {
+                    mLogger.printError(errmsg);
+                    return Result::Fail;
+                }
+                if (mSettings.diff.empty()) {
+                    mLogger.printError("no changed lines found in the diff.");
+                    return Result::Fail;
+                }
+            }
+
             else if (std::strncmp(argv[i], "--disable=", 10) == 0) {
                 const std::string errmsg = mSettings.removeEnabled(argv[i] + 10);
                 if (!errmsg.empty()) {
@@ -718,6 +779,10 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
             else if (std::strcmp(argv[i], "--funsigned-char") == 0)
                 mSettings.platform.defaultSign = 'u';
 
+            // Reuse the results of unchanged functions
+            else if (std::strcmp(argv[i], "--function-cache") == 0)
+                mSettings.functionCache = true;
+
             // Ignored paths
             else if (std::strncmp(argv[i], "-i", 2) == 0) {
                 std::string path;
@@ -874,6 +939,10 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
                 mSettings.libraries.emplace_back(argv[i] + 10);
             }
 
+            // Language server on stdin and stdout
+            else if (std::strcmp(argv[i], "--lsp") == 0)
+                mSettings.lsp = true;
+
             // Set maximum number of #ifdef configurations to check
             else if (std::strncmp(argv[i], "--max-configs=", 14) == 0) {
                 int tmp;
@@ -895,6 +964,12 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
                     return Result::Fail;
             }
 
+            // Limit the memory usage of the analysis of a file
+            else if (std::strncmp(argv[i], "--max-memory-per-file=", 22) == 0) {
+                if (!parseNumberArg(argv[i], 22, mSettings.maxMemoryPerFile, true))
+                    return Result::Fail;
+            }
+
             else if (std::strcmp(argv[i], "--no-cpp-header-probe") == 0) {
                 mSettings.cppHeaderProbe = false;
             }
@@ -1058,6 +1133,10 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
             else if (std::strcmp(argv[i], "-q") == 0 || std::strcmp(argv[i], "--quiet") == 0)
                 mSettings.quiet = true;
 
+            // Reduce fully suppressed headers to declarations
+            else if (std::strcmp(argv[i], "--reduce-suppressed-headers") == 0)
+                mSettings.reduceSuppressedHeaders = true;
+
             // Output relative paths
             else if (std::strcmp(argv[i], "-rp") == 0 || std::strcmp(argv[i], "--relative-paths") == 0)
                 mSettings.relativePaths = true;
@@ -1199,6 +1278,29 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
             else if (std::strcmp(argv[i], "--safety") == 0)
                 mSettings.safety = true;
 
+            // Keep the settings resident and check files on request
+            else if (std::strncmp(argv[i], "--server=", 9) == 0) {
+#if !defined(WIN32) && !defined(__MINGW32__)
+                mSettings.serverSocket = argv[i] + 9;
+                if (mSettings.serverSocket.empty()) {
+                    mLogger.printError("no socket specified for '--server'.");
+                    return Result::Fail;
+                }
+#else
+                mLogger.printError("Option --server is not supported on this platform.");
+                return Result::Fail;
+#endif
+            }
+
+            // show heap usage
+            else if (std::strcmp(argv[i], "--showmemory") == 0) {
+                if (!MemoryUsage::isHooked()) {
+                    mLogger.printError("--showmemory is not supported by this build.");
+                    return Result::Fail;
+                }
+                mSettings.showmemory = true;
+            }
+
             // show timing information..
             else if (std::strncmp(argv[i], "--showtime=", 11) == 0) {
                 const std::string showtimeMode = argv[i] + 11;
@@ -1216,6 +1318,8 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
                     mSettings.showtime = SHOWTIME_MODES::SHOWTIME_TOP5_FILE;
                 else if (showtimeMode == "top5_summary")
                     mSettings.showtime = SHOWTIME_MODES::SHOWTIME_TOP5_SUMMARY;
+                else if (showtimeMode == "counters")
+                    mSettings.showtime = SHOWTIME_MODES::SHOWTIME_COUNTERS;
                 else if (showtimeMode == "none")
                     mSettings.showtime = SHOWTIME_MODES::SHOWTIME_NONE;
                 else if (showtimeMode.empty()) {
@@ -1223,7 +1327,7 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
                     return Result::Fail;
                 }
                 else {
-                    mLogger.printError("unrecognized --showtime mode: '" + showtimeMode + "'. Supported modes: file, file-total, summary, top5, top5_file, top5_summary.");
+                    mLogger.printError("unrecognized --showtime mode: '" + showtimeMode + "'. Supported modes: file, file-total, summary, top5, top5_file, top5_summary, counters.");
                     return Result::Fail;
                 }
             }
@@ -1415,6 +1519,33 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
         return Result::Fail;
     }
 
+    if (mSettings.lsp) {
+        if (!mSettings.serverSocket.empty() || !mSettings.clientSocket.empty()) {
+            mLogger.printError("'--lsp' cannot be used in conjunction with '--server' or '--client'.");
+            return Result::Fail;
+        }
+        if (!mPathNames.empty() || project.projectType != ImportProject::Type::NONE) {
+            mLogger.printError("'--lsp' cannot be used in conjunction with source files or projects.");
+            return Result::Fail;
+        }
+        // the files are opened in the editor
+        return Result::Success;
+    }
+
+    if (!mSettings.serverSocket.empty()) {
+        if (!mSettings.clientSocket.empty()) {
+            mLogger.printError("'--server' cannot be used in conjunction with '--client'.");
+            return Result::Fail;
+        }
+        if (!mPathNames.empty()) {
+            mLogger.printError("'--server' cannot be used in conjunction with source files.");
+            return Result::Fail;
+        }
+        // the files are provided by the clients
+        if (project.fileSettings.empty())
+            return Result::Success;
+    }
+
     // Print error only if we have "real" command and expect files
     if (mPathNames.empty() && project.guiProject.pathNames.empty() && project.fileSettings.empty()) {
         // TODO: this message differs from the one reported in fillSettingsFromArgs()
@@ -1492,6 +1623,9 @@ void CmdLineParser::printHelp() const
         "                         Cppcheck data. After that the normal Cppcheck analysis is\n"
         "                         used. You must have the executable in PATH if no path is\n"
         "                         given.\n"
+        "    --client=<socket>    Let the analysis server listening on the given Unix\n"
+        "                         domain socket check the files. The analysis options of\n"
+        "                         the server are used. See --server.\n"
         "    --config-exclude=<dir>\n"
         "                         Path (prefix) to be excluded from configuration\n"
         "                         checking. Preprocessor configurations defined in\n"
@@ -1499,6 +1633,12 @@ void CmdLineParser::printHelp() const
         "                         be considered for evaluation.\n"
         "    --config-excludes-file=<file>\n"
         "                         A file that contains a list of config-excludes\n"
+        "    --diff=<file>        Check only the files of the given unified diff and\n"
+        "                         report only the findings in the changed lines. The\n"
+        "                         function bodies that are not changed and that are not\n"
+        "                         called by or calling a changed function are skipped.\n"
+        "                         Use - to read the diff from stdin. Whole program\n"
+        "                         checks only see the files of the diff.\n"
         "    --disable=<id>       Disable individual checks.\n"
         "                         Please refer to the documentation of --enable=<id>\n"
         "                         for further details.\n"
@@ -1557,6 +1697,11 @@ void CmdLineParser::printHelp() const
         "                         one that is effective.\n"
         "    --fsigned-char       Treat char type as signed.\n"
         "    --funsigned-char     Treat char type as unsigned.\n"
+        "    --function-cache     Store the findings per function in the build dir given\n"
+        "                         by '--cppcheck-build-dir'. When a file is changed, the\n"
+        "                         functions whose code and dependencies are unchanged are\n"
+        "                         not analyzed again, their findings are reused. Not\n"
+        "                         used together with unusedFunction, --dump and addons.\n"
         "    -h, --help           Print this help.\n"
         "    -I <dir>             Give path to search for include files. Give several -I\n"
         "                         parameters to give several paths. First given path is\n"
@@ -1596,6 +1741,10 @@ void CmdLineParser::printHelp() const
         "                         distributed with Cppcheck is loaded automatically.\n"
         "                         For more information about library files, read the\n"
         "                         manual.\n"
+        "    --lsp                Run as language server. The editor communicates through\n"
+        "                         stdin and stdout using the Language Server Protocol.\n"
+        "                         Open documents are checked with their unsaved content\n"
+        "                         and the findings are published as diagnostics.\n"
         "    --max-configs=<limit>\n"
         "                         Maximum number of configurations to check in a file\n"
         "                         before skipping it. Default is '12'. If used together\n"
@@ -1604,6 +1753,12 @@ void CmdLineParser::printHelp() const
         "    --max-ctu-depth=N    Max depth in whole program analysis. The default value\n"
         "                         is 2. A larger value will mean more errors can be found\n"
         "                         but also means the analysis will be slower.\n"
+        "    --max-memory-per-file=<MiB>\n"
+        "                         When the analysis of a file uses more heap memory than\n"
+        "                         this, the remaining ValueFlow analysis and checks of\n"
+        "                         the file are skipped. With the process executor, the\n"
+        "                         address space of the process that checks a file is\n"
+        "                         limited too. The default value is 0 (no limit).\n"
         "    --output-file=<file> Write results to file, rather than standard error.\n"
         "    --platform=<type>, --platform=<file>\n"
         "                         Specifies platform specific types and sizes. The\n"
@@ -1671,6 +1826,12 @@ void CmdLineParser::printHelp() const
         "                         For example: '--project-configuration=Release|Win32'\n"
         "    -q, --quiet          Do not show progress reports.\n"
         "                         Note that this option is not mutually exclusive with --verbose.\n"
+        "    --reduce-suppressed-headers\n"
+        "                         Remove function bodies from headers where all\n"
+        "                         messages are suppressed (--suppress=*:<path>) unless\n"
+        "                         the function is used outside such headers. This saves\n"
+        "                         time, but the analysis of the checked code may lose\n"
+        "                         information.\n"
         "    -rp=<paths>, --relative-paths=<paths>\n"
         "                         Use relative paths in output. When given, <paths> are\n"
         "                         used as base. You can separate multiple paths by ';'.\n"
@@ -1683,6 +1844,16 @@ void CmdLineParser::printHelp() const
         "    --rule=<rule>        Match regular expression.\n"
         "    --rule-file=<file>   Use given rule file. For more information, see:\n"
         "                         http://sourceforge.net/projects/cppcheck/files/Articles/\n"
+        "    --server=<socket>    Keep the configuration, the libraries and the project\n"
+        "                         loaded and check the files which clients send through\n"
+        "                         the given Unix domain socket. This avoids the startup\n"
+        "                         cost when only a few files are checked at a time.\n"
+        "                         Example: 'cppcheck --server=/tmp/cppcheck.sock\n"
+        "                         --library=qt' and 'cppcheck --client=/tmp/cppcheck.sock\n"
+        "                         file.cpp'.\n"
+        "    --showmemory         Show the heap high-water marks of each file and of the\n"
+        "                         phases of its analysis, and a summary of the top 5\n"
+        "                         files and phases at the end.\n"
         "    --showtime=<mode>    Show timing information.\n"
         "                         The available modes are:\n"
         "                          * none\n"
@@ -1699,6 +1870,11 @@ void CmdLineParser::printHelp() const
         "                                 Show the top 5 summary at the end\n"
         "                          * top5\n"
         "                                 Alias for top5_file (deprecated)\n"
+        "                          * counters\n"
+        "                                 Show a summary at the end with the hardware\n"
+        "                                 performance counters (instructions, cycles,\n"
+        "                                 cache misses, branch misses) of each phase.\n"
+        "                                 Only available on Linux.\n"
         "    --std=<id>           Set standard.\n"
         "                         The available options are:\n"
         "                          * c89\n"
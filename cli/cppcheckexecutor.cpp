@@ -18,6 +18,7 @@
 
 #include "cppcheckexecutor.h"
 
+#include "analysisserver.h"
 #include "analyzerinfo.h"
 #include "checkersreport.h"
 #include "cmdlinelogger.h"
@@ -28,6 +29,7 @@
 #include "errorlogger.h"
 #include "errortypes.h"
 #include "filesettings.h"
+#include "lspserver.h"
 #include "settings.h"
 #include "singleexecutor.h"
 #include "suppressions.h"
@@ -251,6 +253,18 @@ int CppCheckExecutor::check_internal(const Settings& settings) const
 {
     StdLogger stdLogger(settings);
 
+    if (settings.lsp) {
+        LspServer server(settings, std::cin, std::cout, executeCommand);
+        return server.run();
+    }
+
+#if !defined(WIN32) && !defined(__MINGW32__)
+    if (!settings.serverSocket.empty()) {
+        AnalysisServer server(settings, mFileSettings, stdLogger, executeCommand);
+        return server.run(settings.serverSocket) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+#endif
+
     if (settings.reportProgress >= 0)
         stdLogger.resetLatestProgressOutputTime();
 
@@ -273,7 +287,17 @@ int CppCheckExecutor::check_internal(const Settings& settings) const
     auto& suppressions = cppcheck.settings().supprs.nomsg;
 
     unsigned int returnValue = 0;
-    if (settings.useSingleJob()) {
+    if (!settings.clientSocket.empty()) {
+#if !defined(WIN32) && !defined(__MINGW32__)
+        // the files are checked by the analysis server
+        const int res = AnalysisServer::check(settings.clientSocket, mFiles, stdLogger, settings.quiet);
+        if (res < 0) {
+            std::cout << "cppcheck: error: could not communicate with the analysis server at '" << settings.clientSocket << "'." << std::endl;
+            return EXIT_FAILURE;
+        }
+        returnValue = res;
+#endif
+    } else if (settings.useSingleJob()) {
         // Single process
         SingleExecutor executor(cppcheck, mFiles, mFileSettings, settings, suppressions, stdLogger);
         returnValue = executor.check();
@@ -292,9 +316,13 @@ int CppCheckExecutor::check_internal(const Settings& settings) const
 #endif
     }
 
-    returnValue |= cppcheck.analyseWholeProgram(settings.buildDir, mFiles, mFileSettings);
+    // the analysis server does not keep whole program information and suppressions of the client are not used
+    const bool isClient = !settings.clientSocket.empty();
+
+    if (!isClient)
+        returnValue |= cppcheck.analyseWholeProgram(settings.buildDir, mFiles, mFileSettings);
 
-    if (settings.severity.isEnabled(Severity::information) || settings.checkConfiguration) {
+    if (!isClient && (settings.severity.isEnabled(Severity::information) || settings.checkConfiguration)) {
         const bool err = reportSuppressions(settings, suppressions, settings.checks.isEnabled(Checks::unusedFunction), mFiles, mFileSettings, stdLogger);
         if (err && returnValue == 0)
             returnValue = settings.exitCode;
@@ -0,0 +1,429 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lspserver.h"
+
+#include "color.h"
+#include "cppcheck.h"
+#include "errorlogger.h"
+#include "errortypes.h"
+#include "filesettings.h"
+#include "json.h"
+#include "path.h"
+#include "settings.h"
+#include "utils.h"
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <set>
+#include <utility>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace {
+    /** JSON-RPC error code for unknown methods */
+    constexpr std::int64_t MethodNotFound = -32601;
+
+    /** Member of a JSON object, null if there is no such member */
+    const picojson::value &member(const picojson::value &value, const std::string &key)
+    {
+        static const picojson::value null;
+        return value.is<picojson::object>() ? value.get(key) : null;
+    }
+
+    std::string uriToPath(const std::string &uri)
+    {
+        std::string path = startsWith(uri, "file://") ? uri.substr(7) : uri;
+        std::string decoded;
+        decoded.reserve(path.size());
+        for (std::string::size_type i = 0; i < path.size(); ++i) {
+            if (path[i] == '%' && i + 2 < path.size() && std::isxdigit(static_cast<unsigned char>(path[i + 1])) && std::isxdigit(static_cast<unsigned char>(path[i + 2]))) {
+                decoded += static_cast<char>(std::strtol(path.substr(i + 1, 2).c_str(), nullptr, 16));
+                i += 2;
+            } else {
+                decoded += path[i];
+            }
+        }
+#ifdef _WIN32
+        // file:///c:/dir/file.cpp
+        if (decoded.size() > 2 && decoded[0] == '/' && decoded[2] == ':')
+            decoded.erase(0, 1);
+#endif
+        return decoded;
+    }
+
+    std::int64_t lspSeverity(Severity severity)
+    {
+        switch (severity) {
+        case Severity::error:
+            return 1;
+        case Severity::warning:
+            return 2;
+        case Severity::style:
+        case Severity::performance:
+        case Severity::portability:
+            return 3;
+        case Severity::none:
+        case Severity::information:
+        case Severity::debug:
+        case Severity::internal:
+            break;
+        }
+        return 4;
+    }
+
+    picojson::value position(int line, unsigned int column)
+    {
+        picojson::object pos;
+        pos["line"] = picojson::value(static_cast<std::int64_t>(line > 0 ? line - 1 : 0));
+        pos["character"] = picojson::value(static_cast<std::int64_t>(column > 0 ? column - 1 : 0));
+        return picojson::value(pos);
+    }
+
+    /** Collects the findings in the analyzed document as LSP diagnostics */
+    class DiagnosticsLogger : public ErrorLogger {
+    public:
+        DiagnosticsLogger(std::string path, std::function<void(const picojson::array&)> publish)
+            : mPath(Path::simplifyPath(std::move(path)))
+            , mPublish(std::move(publish))
+        {}
+
+        void reportOut(const std::string & /*outmsg*/, Color /*c*/) override {}
+
+        void reportErr(const ErrorMessage &msg) override {
+            if (msg.severity == Severity::internal)
+                return;
+
+            // findings in included files are not reported for this document
+            const ErrorMessage::FileLocation *loc = nullptr;
+            for (auto it = msg.callStack.crbegin(); it != msg.callStack.crend(); ++it) {
+                if (Path::simplifyPath(it->getOrigFile(false)) == mPath) {
+                    loc = &*it;
+                    break;
+                }
+            }
+            if (!loc && !msg.callStack.empty())
+                return;
+
+            const int line = loc ? loc->line : 0;
+            const unsigned int column = loc ? loc->column : 0;
+            if (!mShown.insert(std::to_string(line) + ':' + std::to_string(column) + ':' + msg.id + ':' + msg.shortMessage()).second)
+                return;
+
+            picojson::object range;
+            range["start"] = position(line, column);
+            range["end"] = position(line, column);
+
+            picojson::object diagnostic;
+            diagnostic["range"] = picojson::value(range);
+            diagnostic["severity"] = picojson::value(lspSeverity(msg.severity));
+            diagnostic["code"] = picojson::value(msg.id);
+            diagnostic["source"] = picojson::value("cppcheck");
+            diagnostic["message"] = picojson::value(msg.shortMessage());
+            mDiagnostics.emplace_back(diagnostic);
+
+            mPublish(mDiagnostics);
+        }
+
+        const picojson::array &diagnostics() const {
+            return mDiagnostics;
+        }
+
+    private:
+        const std::string mPath;
+        const std::function<void(const picojson::array&)> mPublish;
+        picojson::array mDiagnostics;
+        std::set<std::string> mShown;
+    };
+}
+
+LspServer::LspServer(const Settings &settings, std::istream &in, std::ostream &out, CppCheck::ExecuteCmdFn executeCommand)
+    : mSettings(settings)
+    , mIn(in)
+    , mOut(out)
+    , mExecuteCommand(std::move(executeCommand))
+{
+    mWorker = std::thread(&LspServer::worker, this);
+}
+
+LspServer::~LspServer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+        if (!mAnalyzing.empty()) {
+            mCancelled = true;
+            Settings::terminate();
+        }
+    }
+    mCondition.notify_all();
+    mWorker.join();
+}
+
+int LspServer::run()
+{
+#ifdef _WIN32
+    // the content length counts the bytes so no line ending conversion must take place
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    std::string line;
+    while (!mExit) {
+        std::size_t length = 0;
+        bool hasLength = false;
+        while (std::getline(mIn, line)) {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line.empty())
+                break;
+            static const std::string contentLength = "content-length:";
+            strTolower(line);
+            if (startsWith(line, contentLength)) {
+                length = std::strtoul(line.c_str() + contentLength.size(), nullptr, 10);
+                hasLength = true;
+            }
+        }
+        if (!mIn || !hasLength)
+            break;
+
+        std::string message(length, '\0');
+        if (!mIn.read(&message[0], length))
+            break;
+        handleMessage(message);
+    }
+
+    return mShutdown ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void LspServer::handleMessage(const std::string &message)
+{
+    picojson::value json;
+    if (!picojson::parse(json, message).empty() || !json.is<picojson::object>())
+        return;
+    const picojson::object &obj = json.get<picojson::object>();
+
+    const auto methodIt = obj.find("method");
+    if (methodIt == obj.end() || !methodIt->second.is<std::string>())
+        return; // responses to our requests are not expected
+    const std::string &method = methodIt->second.get<std::string>();
+
+    const auto paramsIt = obj.find("params");
+    const picojson::value params = (paramsIt != obj.end()) ? paramsIt->second : picojson::value();
+    const picojson::value &document = member(params, "textDocument");
+    const picojson::value &uriValue = member(document, "uri");
+    const std::string uri = uriValue.is<std::string>() ? uriValue.get<std::string>() : std::string();
+    const picojson::value &versionValue = member(document, "version");
+    const long long version = versionValue.is<std::int64_t>() ? versionValue.get<std::int64_t>() : 0;
+
+    const auto idIt = obj.find("id");
+    if (idIt != obj.end()) {
+        picojson::object response;
+        response["jsonrpc"] = picojson::value("2.0");
+        response["id"] = idIt->second;
+        if (method == "initialize") {
+            picojson::object save;
+            save["includeText"] = picojson::value(false);
+            picojson::object sync;
+            sync["openClose"] = picojson::value(true);
+            sync["change"] = picojson::value(static_cast<std::int64_t>(1)); // full content
+            sync["save"] = picojson::value(save);
+            picojson::object capabilities;
+            capabilities["textDocumentSync"] = picojson::value(sync);
+            picojson::object serverInfo;
+            serverInfo["name"] = picojson::value("cppcheck");
+            serverInfo["version"] = picojson::value(CppCheck::version());
+            picojson::object result;
+            result["capabilities"] = picojson::value(capabilities);
+            result["serverInfo"] = picojson::value(serverInfo);
+            response["result"] = picojson::value(result);
+        } else if (method == "shutdown") {
+            mShutdown = true;
+            response["result"] = picojson::value();
+        } else {
+            picojson::object error;
+            error["code"] = picojson::value(MethodNotFound);
+            error["message"] = picojson::value("unsupported method '" + method + "'");
+            response["error"] = picojson::value(error);
+        }
+        send(picojson::value(response).serialize());
+        return;
+    }
+
+    if (method == "exit") {
+        mExit = true;
+    } else if (method == "textDocument/didOpen") {
+        const picojson::value &text = member(document, "text");
+        if (uri.empty() || !text.is<std::string>())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            Document &doc = mDocuments[uri];
+            doc.path = uriToPath(uri);
+            doc.text = text.get<std::string>();
+            doc.version = version;
+        }
+        schedule(uri, std::chrono::milliseconds(0));
+    } else if (method == "textDocument/didChange") {
+        const picojson::value &changes = member(params, "contentChanges");
+        if (uri.empty() || !changes.is<picojson::array>() || changes.get<picojson::array>().empty())
+            return;
+        // only full content changes are announced in the capabilities
+        const picojson::value &text = member(changes.get<picojson::array>().back(), "text");
+        if (!text.is<std::string>())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            const auto it = mDocuments.find(uri);
+            if (it == mDocuments.end())
+                return;
+            it->second.text = text.get<std::string>();
+            it->second.version = version;
+        }
+        schedule(uri, debounce);
+    } else if (method == "textDocument/didSave") {
+        schedule(uri, std::chrono::milliseconds(0));
+    } else if (method == "textDocument/didClose") {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mDocuments.erase(uri) == 0)
+                return;
+            if (mAnalyzing == uri) {
+                mCancelled = true;
+                Settings::terminate();
+            }
+        }
+        publishDiagnostics(uri, "[]", -1);
+    }
+}
+
+void LspServer::schedule(const std::string &uri, std::chrono::milliseconds delay)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const auto it = mDocuments.find(uri);
+        if (it == mDocuments.end())
+            return;
+        it->second.dirty = true;
+        it->second.due = std::chrono::steady_clock::now() + delay;
+        // the results of the running analysis are outdated
+        if (mAnalyzing == uri) {
+            mCancelled = true;
+            Settings::terminate();
+        }
+    }
+    mCondition.notify_all();
+}
+
+void LspServer::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [this]() {
+        if (!mAnalyzing.empty())
+            return false;
+        for (const auto &doc : mDocuments) {
+            if (doc.second.dirty)
+                return false;
+        }
+        return true;
+    });
+}
+
+void LspServer::worker()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (!mStop) {
+        auto next = mDocuments.end();
+        for (auto it = mDocuments.begin(); it != mDocuments.end(); ++it) {
+            if (it->second.dirty && (next == mDocuments.end() || it->second.due < next->second.due))
+                next = it;
+        }
+        if (next == mDocuments.end()) {
+            mCondition.notify_all(); // idle
+            mCondition.wait(lock);
+            continue;
+        }
+        if (next->second.due > std::chrono::steady_clock::now()) {
+            mCondition.wait_until(lock, next->second.due);
+            continue;
+        }
+
+        next->second.dirty = false;
+        const std::string uri = next->first;
+        const std::string path = next->second.path;
+        const std::string text = next->second.text;
+        const long long version = next->second.version;
+        mAnalyzing = uri;
+
+        lock.unlock();
+        analyze(uri, path, text, version);
+        lock.lock();
+
+        mAnalyzing.clear();
+        if (mCancelled) {
+            mCancelled = false;
+            Settings::terminate(false);
+        }
+    }
+}
+
+void LspServer::analyze(const std::string &uri, const std::string &path, const std::string &text, long long version)
+{
+    DiagnosticsLogger logger(path, [&](const picojson::array &diagnostics) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mCancelled)
+            publishDiagnostics(uri, picojson::value(diagnostics).serialize(), version);
+    });
+
+    // a fresh instance so no state accumulates over the lifetime of the server
+    CppCheck cppcheck(logger, true, mExecuteCommand);
+    cppcheck.settings() = mSettings; // this is a copy
+    try {
+        cppcheck.check(FileWithDetails(path), text);
+    } catch (const std::exception &) {
+        // the document is analyzed again on the next change
+        return;
+    }
+
+    // publish the final state also when nothing was found
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mCancelled)
+        publishDiagnostics(uri, picojson::value(logger.diagnostics()).serialize(), version);
+}
+
+void LspServer::publishDiagnostics(const std::string &uri, const std::string &diagnostics, long long version)
+{
+    std::string params = "{\"diagnostics\":" + diagnostics + ",\"uri\":" + picojson::value(uri).serialize();
+    if (version >= 0)
+        params += ",\"version\":" + std::to_string(version);
+    params += '}';
+    send("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":" + params + "}");
+}
+
+void LspServer::send(const std::string &message)
+{
+    std::lock_guard<std::mutex> lock(mOutputMutex);
+    mOut << "Content-Length: " << message.size() << "\r\n\r\n" << message;
+    mOut.flush();
+}
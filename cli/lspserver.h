@@ -0,0 +1,108 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSPSERVER_H
+#define LSPSERVER_H
+
+#include "cppcheck.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+class Settings;
+
+/// @addtogroup CLI
+/// @{
+
+/**
+ * Language Server Protocol front end (--lsp).
+ *
+ * Reads JSON-RPC messages from the input and writes responses and
+ * notifications to the output. Open documents are analyzed with their
+ * unsaved content in a background thread and the findings are published
+ * as diagnostics while the analysis is running. Changes are debounced and
+ * an analysis which is in progress is cancelled when the document changes.
+ */
+class LspServer {
+public:
+    LspServer(const Settings &settings, std::istream &in, std::ostream &out, CppCheck::ExecuteCmdFn executeCommand);
+    ~LspServer();
+    LspServer(const LspServer &) = delete;
+    LspServer& operator=(const LspServer &) = delete;
+
+    /**
+     * Process messages until the client sends exit or closes the input.
+     * @return the exit code
+     */
+    int run();
+
+    /** Handle one JSON-RPC message */
+    void handleMessage(const std::string &message);
+
+    /** Wait until all scheduled analyses are done */
+    void waitIdle();
+
+    /** Time to wait after a change before the document is analyzed */
+    std::chrono::milliseconds debounce{300};
+
+private:
+    struct Document {
+        std::string path;
+        std::string text;
+        long long version{};
+        /** the document has to be analyzed */
+        bool dirty{};
+        std::chrono::steady_clock::time_point due;
+    };
+
+    void schedule(const std::string &uri, std::chrono::milliseconds delay);
+    void worker();
+    void analyze(const std::string &uri, const std::string &path, const std::string &text, long long version);
+    void publishDiagnostics(const std::string &uri, const std::string &diagnostics, long long version);
+    void send(const std::string &message);
+
+    const Settings &mSettings;
+    std::istream &mIn;
+    std::ostream &mOut;
+    CppCheck::ExecuteCmdFn mExecuteCommand;
+
+    bool mShutdown{};
+    bool mExit{};
+
+    std::mutex mOutputMutex;
+
+    /** protects the documents and the state of the worker */
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::map<std::string, Document> mDocuments;
+    /** uri of the document that is being analyzed */
+    std::string mAnalyzing;
+    bool mCancelled{};
+    bool mStop{};
+    std::thread mWorker;
+};
+
+/// @}
+
+#endif // LSPSERVER_H
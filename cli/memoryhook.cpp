@@ -0,0 +1,88 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Global operator new and delete that count the heap usage for --showmemory.
+// The sanitizers have their own operator new and delete, they are not replaced.
+
+#include "memoryusage.h"
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer) || __has_feature(thread_sanitizer)
+#define NO_MEMORY_HOOK
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define NO_MEMORY_HOOK
+#endif
+
+#if !defined(NO_MEMORY_HOOK) && (defined(__linux__) || defined(__APPLE__) || defined(_MSC_VER))
+
+#include <cstdlib>
+#include <new>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+static std::size_t usableSize(void *p)
+{
+#if defined(__APPLE__)
+    return malloc_size(p);
+#elif defined(_MSC_VER)
+    return _msize(p);
+#else
+    return malloc_usable_size(p);
+#endif
+}
+
+namespace {
+    struct MemoryHook {
+        MemoryHook() {
+            MemoryUsage::setHooked();
+        }
+    } memoryHook;
+}
+
+void *operator new(std::size_t size)
+{
+    for (;;) {
+        void *p = std::malloc(size == 0 ? 1 : size);
+        if (p) {
+            if (MemoryUsage::isCounting())
+                MemoryUsage::allocated(usableSize(p));
+            return p;
+        }
+        const std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void *p) noexcept
+{
+    if (!p)
+        return;
+    if (MemoryUsage::isCounting())
+        MemoryUsage::deallocated(usableSize(p));
+    std::free(p);
+}
+
+#endif
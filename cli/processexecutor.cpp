@@ -25,6 +25,7 @@
 #include "errorlogger.h"
 #include "errortypes.h"
 #include "filesettings.h"
+#include "memoryusage.h"
 #include "settings.h"
 #include "suppressions.h"
 #include "timer.h"
@@ -36,10 +37,12 @@
 #include <csignal>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <list>
 #include <map>
 #include <sstream>
+#include <sys/resource.h>
 #include <sys/select.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -73,7 +76,7 @@ ProcessExecutor::ProcessExecutor(const std::list<FileWithDetails> &files, const
 namespace {
     class PipeWriter : public ErrorLogger {
     public:
-        enum PipeSignal : std::uint8_t {REPORT_OUT='1',REPORT_ERROR='2', CHILD_END='5'};
+        enum PipeSignal : std::uint8_t {REPORT_OUT='1',REPORT_ERROR='2',REPORT_MEMORY='3',CHILD_END='5'};
 
         explicit PipeWriter(int pipe) : mWpipe(pipe) {}
 
@@ -85,6 +88,10 @@ namespace {
             writeToPipe(REPORT_ERROR, msg.serialize());
         }
 
+        void writeMemory(const MemoryUsage::FileResults &results) const {
+            writeToPipe(REPORT_MEMORY, results.serialize());
+        }
+
         void writeEnd(const std::string& str) const {
             writeToPipe(CHILD_END, str);
         }
@@ -149,7 +156,7 @@ bool ProcessExecutor::handleRead(int rpipe, unsigned int &result, const std::str
         std::exit(EXIT_FAILURE);
     }
 
-    if (type != PipeWriter::REPORT_OUT && type != PipeWriter::REPORT_ERROR && type != PipeWriter::CHILD_END) {
+    if (type != PipeWriter::REPORT_OUT && type != PipeWriter::REPORT_ERROR && type != PipeWriter::REPORT_MEMORY && type != PipeWriter::CHILD_END) {
         std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") invalid type " << int(type) << std::endl;
         std::exit(EXIT_FAILURE);
     }
@@ -198,6 +205,15 @@ bool ProcessExecutor::handleRead(int rpipe, unsigned int &result, const std::str
 
         if (hasToLog(msg))
             mErrorLogger.reportErr(msg);
+    } else if (type == PipeWriter::REPORT_MEMORY) {
+        MemoryUsage::FileResults results;
+        try {
+            results.deserialize(buf);
+        } catch (const InternalError& e) {
+            std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") internal error: " << e.errorMessage << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        MemoryUsage::addResults(std::move(results));
     } else if (type == PipeWriter::CHILD_END) {
         result += std::stoi(buf);
         res = false;
@@ -228,6 +244,32 @@ bool ProcessExecutor::checkLoadAverage(size_t nchildren)
 #endif
 }
 
+/**
+ * Limit the address space of a child to its current size plus twice the memory limit of a file.
+ * The margin lets the analysis bail out gracefully when the heap usage exceeds the limit. The
+ * address space limit stops the allocations that happen before the bailout can take place.
+ */
+static void limitAddressSpace(int maxMemoryPerFile)
+{
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    unsigned long pages = 0;
+    if (!(statm >> pages))
+        return;
+    rlimit limit{};
+    if (getrlimit(RLIMIT_AS, &limit) != 0)
+        return;
+    const rlim_t size = static_cast<rlim_t>(pages) * static_cast<rlim_t>(sysconf(_SC_PAGESIZE)) + 2 * static_cast<rlim_t>(maxMemoryPerFile) * 1024 * 1024;
+    // never raise a limit that is already set
+    if (limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur <= size)
+        return;
+    limit.rlim_cur = size;
+    setrlimit(RLIMIT_AS, &limit);
+#else
+    (void)maxMemoryPerFile;
+#endif
+}
+
 unsigned int ProcessExecutor::check()
 {
     unsigned int fileCount = 0;
@@ -275,6 +317,9 @@ unsigned int ProcessExecutor::check()
 #endif
                 close(pipes[0]);
 
+                if (mSettings.maxMemoryPerFile > 0)
+                    limitAddressSpace(mSettings.maxMemoryPerFile);
+
                 PipeWriter pipewriter(pipes[1]);
                 CppCheck fileChecker(pipewriter, false, mExecuteCommand);
                 fileChecker.settings() = mSettings;
@@ -290,6 +335,8 @@ unsigned int ProcessExecutor::check()
                     // TODO: call analyseClangTidy()?
                 }
 
+                for (const MemoryUsage::FileResults &results : MemoryUsage::takeResults())
+                    pipewriter.writeMemory(results);
                 pipewriter.writeEnd(std::to_string(resultOfCheck));
                 std::exit(EXIT_SUCCESS);
             }
@@ -384,8 +431,11 @@ unsigned int ProcessExecutor::check()
     }
 
     // TODO: wee need to get the timing information from the subprocess
-    if (mSettings.showtime == SHOWTIME_MODES::SHOWTIME_SUMMARY || mSettings.showtime == SHOWTIME_MODES::SHOWTIME_TOP5_SUMMARY)
+    if (mSettings.showtime == SHOWTIME_MODES::SHOWTIME_SUMMARY || mSettings.showtime == SHOWTIME_MODES::SHOWTIME_TOP5_SUMMARY ||
+        mSettings.showtime == SHOWTIME_MODES::SHOWTIME_COUNTERS)
         CppCheck::printTimerResults(mSettings.showtime);
+    if (mSettings.showmemory)
+        mErrorLogger.reportOut(MemoryUsage::summary(5));
 
     return result;
 }
@@ -20,6 +20,7 @@
 
 #include "cppcheck.h"
 #include "filesettings.h"
+#include "memoryusage.h"
 #include "settings.h"
 #include "timer.h"
 
@@ -72,8 +73,11 @@ unsigned int SingleExecutor::check()
     if (mCppcheck.analyseWholeProgram())
         result++;
 
-    if (mSettings.showtime == SHOWTIME_MODES::SHOWTIME_SUMMARY || mSettings.showtime == SHOWTIME_MODES::SHOWTIME_TOP5_SUMMARY)
+    if (mSettings.showtime == SHOWTIME_MODES::SHOWTIME_SUMMARY || mSettings.showtime == SHOWTIME_MODES::SHOWTIME_TOP5_SUMMARY ||
+        mSettings.showtime == SHOWTIME_MODES::SHOWTIME_COUNTERS)
         CppCheck::printTimerResults(mSettings.showtime);
+    if (mSettings.showmemory)
+        mErrorLogger.reportOut(MemoryUsage::summary(5));
 
     return result;
 }
@@ -22,6 +22,7 @@
 #include "cppcheck.h"
 #include "errorlogger.h"
 #include "filesettings.h"
+#include "memoryusage.h"
 #include "settings.h"
 #include "timer.h"
 
@@ -197,8 +198,11 @@ unsigned int ThreadExecutor::check()
         return v + f.get();
     });
 
-    if (mSettings.showtime == SHOWTIME_MODES::SHOWTIME_SUMMARY || mSettings.showtime == SHOWTIME_MODES::SHOWTIME_TOP5_SUMMARY)
+    if (mSettings.showtime == SHOWTIME_MODES::SHOWTIME_SUMMARY || mSettings.showtime == SHOWTIME_MODES::SHOWTIME_TOP5_SUMMARY ||
+        mSettings.showtime == SHOWTIME_MODES::SHOWTIME_COUNTERS)
         CppCheck::printTimerResults(mSettings.showtime);
+    if (mSettings.showmemory)
+        mErrorLogger.reportOut(MemoryUsage::summary(5));
 
     return result;
 }
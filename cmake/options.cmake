@@ -50,6 +50,7 @@ option(REGISTER_TESTS       "Register tests in CTest"
 option(ENABLE_CHECK_INTERNAL "Enable internal checks"                                       OFF)
 option(DISABLE_DMAKE        "Disable run-dmake dependencies"                                OFF)
 option(BUILD_MANPAGE        "Enable man target to build manpage"                            OFF)
+option(BUILD_BENCHMARKS     "Enable benchmarks and run-benchmarks targets"                  OFF)
 
 option(BUILD_CLI            "Build the cli application"                                     ON)
 
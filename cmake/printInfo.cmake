@@ -57,6 +57,7 @@ endif()
 message(STATUS "ENABLE_CHECK_INTERNAL = ${ENABLE_CHECK_INTERNAL}")
 message(STATUS "DISABLE_DMAKE =         ${DISABLE_DMAKE}")
 message(STATUS "BUILD_MANPAGE =         ${BUILD_MANPAGE}")
+message(STATUS "BUILD_BENCHMARKS =      ${BUILD_BENCHMARKS}")
 message(STATUS)
 message(STATUS "BUILD_CLI =             ${BUILD_CLI}")
 message(STATUS)
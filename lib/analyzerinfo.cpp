@@ -23,8 +23,10 @@
 #include "path.h"
 #include "utils.h"
 
+#include <algorithm>
 #include <cstring>
 #include <map>
+#include <utility>
 
 #include "xml.h"
 
@@ -68,22 +70,24 @@ void AnalyzerInformation::close()
 {
     mAnalyzerInfoFile.clear();
     if (mOutputStream.is_open()) {
+        for (const auto &f : mFunctions) {
+            const Function &function = f.second.function;
+            mOutputStream << "  <function hash=\"" << function.hash << "\" file=\"" << ErrorLogger::toxml(function.file)
+                          << "\" first=\"" << function.first << "\" last=\"" << function.last << "\">\n";
+            for (const ErrorMessage &msg : f.second.errors)
+                mOutputStream << msg.toXML() << '\n';
+            mOutputStream << "  </function>\n";
+        }
         mOutputStream << "</analyzerinfo>\n";
         mOutputStream.close();
     }
+    mPreviousFunctions.clear();
+    mFunctions.clear();
+    mCurrentFunctions.clear();
 }
 
-static bool skipAnalysis(const std::string &analyzerInfoFile, std::size_t hash, std::list<ErrorMessage> &errors)
+static bool skipAnalysis(const tinyxml2::XMLElement *rootNode, std::uint64_t hash, std::list<ErrorMessage> &errors)
 {
-    tinyxml2::XMLDocument doc;
-    const tinyxml2::XMLError error = doc.LoadFile(analyzerInfoFile.c_str());
-    if (error != tinyxml2::XML_SUCCESS)
-        return false;
-
-    const tinyxml2::XMLElement * const rootNode = doc.FirstChildElement();
-    if (rootNode == nullptr)
-        return false;
-
     const char *attr = rootNode->Attribute("hash");
     if (!attr || attr != std::to_string(hash))
         return false;
@@ -91,11 +95,46 @@ static bool skipAnalysis(const std::string &analyzerInfoFile, std::size_t hash,
     for (const tinyxml2::XMLElement *e = rootNode->FirstChildElement(); e; e = e->NextSiblingElement()) {
         if (std::strcmp(e->Name(), "error") == 0)
             errors.emplace_back(e);
+        else if (std::strcmp(e->Name(), "function") == 0) {
+            for (const tinyxml2::XMLElement *e2 = e->FirstChildElement("error"); e2; e2 = e2->NextSiblingElement("error"))
+                errors.emplace_back(e2);
+        }
     }
 
     return true;
 }
 
+static bool isSameFile(const std::string &file1, const std::string &file2)
+{
+    return Path::fromNativeSeparators(file1) == Path::fromNativeSeparators(file2);
+}
+
+void AnalyzerInformation::loadFunctionResults(const tinyxml2::XMLElement *rootNode)
+{
+    for (const tinyxml2::XMLElement *e = rootNode->FirstChildElement("function"); e; e = e->NextSiblingElement("function")) {
+        const char *file = e->Attribute("file");
+        if (!file)
+            continue;
+        FunctionResults results;
+        results.function.file = file;
+        results.function.first = e->IntAttribute("first");
+        results.function.last = e->IntAttribute("last");
+        results.function.hash = e->Unsigned64Attribute("hash");
+        for (const tinyxml2::XMLElement *e2 = e->FirstChildElement("error"); e2; e2 = e2->NextSiblingElement("error"))
+            results.errors.emplace_back(e2);
+
+        // the other locations might have been moved
+        const bool local = std::all_of(results.errors.cbegin(), results.errors.cend(), [&](const ErrorMessage &msg) {
+            return std::all_of(msg.callStack.cbegin(), msg.callStack.cend(), [&](const ErrorMessage::FileLocation &loc) {
+                return loc.line >= results.function.first && loc.line <= results.function.last &&
+                       isSameFile(loc.getfile(false), results.function.file);
+            });
+        });
+        if (local)
+            mPreviousFunctions.emplace(results.function.hash, std::move(results));
+    }
+}
+
 std::string AnalyzerInformation::getAnalyzerInfoFileFromFilesTxt(std::istream& filesTxt, const std::string &sourcefile, const std::string &cfg)
 {
     std::string line;
@@ -128,7 +167,7 @@ std::string AnalyzerInformation::getAnalyzerInfoFile(const std::string &buildDir
     return Path::join(buildDir, filename) + ".analyzerinfo";
 }
 
-bool AnalyzerInformation::analyzeFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, std::size_t hash, std::list<ErrorMessage> &errors)
+bool AnalyzerInformation::analyzeFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, std::uint64_t hash, std::list<ErrorMessage> &errors)
 {
     if (buildDir.empty() || sourcefile.empty())
         return true;
@@ -136,8 +175,17 @@ bool AnalyzerInformation::analyzeFile(const std::string &buildDir, const std::st
 
     mAnalyzerInfoFile = AnalyzerInformation::getAnalyzerInfoFile(buildDir,sourcefile,cfg);
 
-    if (skipAnalysis(mAnalyzerInfoFile, hash, errors))
-        return false;
+    {
+        tinyxml2::XMLDocument doc;
+        const tinyxml2::XMLElement *rootNode = nullptr;
+        if (doc.LoadFile(mAnalyzerInfoFile.c_str()) == tinyxml2::XML_SUCCESS)
+            rootNode = doc.FirstChildElement();
+        if (rootNode) {
+            if (skipAnalysis(rootNode, hash, errors))
+                return false;
+            loadFunctionResults(rootNode);
+        }
+    }
 
     mOutputStream.open(mAnalyzerInfoFile);
     if (mOutputStream.is_open()) {
@@ -152,8 +200,19 @@ bool AnalyzerInformation::analyzeFile(const std::string &buildDir, const std::st
 
 void AnalyzerInformation::reportErr(const ErrorMessage &msg)
 {
-    if (mOutputStream.is_open())
-        mOutputStream << msg.toXML() << '\n';
+    if (!mOutputStream.is_open())
+        return;
+    if (!msg.callStack.empty()) {
+        const ErrorMessage::FileLocation &loc = msg.callStack.back();
+        const auto it = std::find_if(mCurrentFunctions.cbegin(), mCurrentFunctions.cend(), [&](const Function &function) {
+            return loc.line >= function.first && loc.line <= function.last && isSameFile(loc.getfile(false), function.file);
+        });
+        if (it != mCurrentFunctions.cend()) {
+            mFunctions[it->hash].errors.push_back(msg);
+            return;
+        }
+    }
+    mOutputStream << msg.toXML() << '\n';
 }
 
 void AnalyzerInformation::setFileInfo(const std::string &check, const std::string &fileInfo)
@@ -161,3 +220,29 @@ void AnalyzerInformation::setFileInfo(const std::string &check, const std::strin
     if (mOutputStream.is_open() && !fileInfo.empty())
         mOutputStream << "  <FileInfo check=\"" << check << "\">\n" << fileInfo << "  </FileInfo>\n";
 }
+
+bool AnalyzerInformation::hasFunctionResults(std::uint64_t hash) const
+{
+    return mPreviousFunctions.find(hash) != mPreviousFunctions.cend();
+}
+
+std::list<ErrorMessage> AnalyzerInformation::getFunctionResults(const Function &function) const
+{
+    const auto it = mPreviousFunctions.find(function.hash);
+    if (it == mPreviousFunctions.cend())
+        return {};
+    std::list<ErrorMessage> errors = it->second.errors;
+    const int offset = function.first - it->second.function.first;
+    for (ErrorMessage &msg : errors) {
+        for (ErrorMessage::FileLocation &loc : msg.callStack)
+            loc.line += offset;
+    }
+    return errors;
+}
+
+void AnalyzerInformation::setFunctions(std::vector<Function> functions)
+{
+    mCurrentFunctions = std::move(functions);
+    for (const Function &function : mCurrentFunctions)
+        mFunctions.emplace(function.hash, FunctionResults{function, {}});
+}
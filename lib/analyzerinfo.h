@@ -22,15 +22,22 @@
 //---------------------------------------------------------------------------
 
 #include "config.h"
+#include "errorlogger.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <list>
+#include <map>
 #include <string>
+#include <vector>
 
-class ErrorMessage;
 struct FileSettings;
 
+namespace tinyxml2 {
+    class XMLElement;
+}
+
 /// @addtogroup Core
 /// @{
 
@@ -40,6 +47,7 @@ struct FileSettings;
  * Store various analysis information:
  * - checksum
  * - error messages
+ * - error messages per function (--function-cache)
  * - whole program analysis data
  *
  * The information can be used for various purposes. It allows:
@@ -55,15 +63,49 @@ public:
 
     /** Close current TU.analyzerinfo file */
     void close();
-    bool analyzeFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, std::size_t hash, std::list<ErrorMessage> &errors);
+    bool analyzeFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, std::uint64_t hash, std::list<ErrorMessage> &errors);
     void reportErr(const ErrorMessage &msg);
     void setFileInfo(const std::string &check, const std::string &fileInfo);
     static std::string getAnalyzerInfoFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg);
+
+    /** @brief A function whose error messages are stored separately */
+    struct Function {
+        std::string file;
+        int first;
+        int last;
+        std::uint64_t hash;
+    };
+
+    /**
+     * Are the error messages of the function known from the previous analysis
+     * of the file? Only results that are located in the function itself are
+     * reused.
+     */
+    bool hasFunctionResults(std::uint64_t hash) const;
+
+    /** Get the error messages of the previous analysis, moved to the current lines of the function */
+    std::list<ErrorMessage> getFunctionResults(const Function &function) const;
+
+    /** Set the functions of the current configuration. Their error messages are stored per function. */
+    void setFunctions(std::vector<Function> functions);
 protected:
     static std::string getAnalyzerInfoFileFromFilesTxt(std::istream& filesTxt, const std::string &sourcefile, const std::string &cfg);
 private:
+    void loadFunctionResults(const tinyxml2::XMLElement *rootNode);
+
+    struct FunctionResults {
+        Function function;
+        std::list<ErrorMessage> errors;
+    };
+
     std::ofstream mOutputStream;
     std::string mAnalyzerInfoFile;
+
+    /** functions from the previous analysis by hash */
+    std::map<std::uint64_t, FunctionResults> mPreviousFunctions;
+    /** functions of this analysis by hash, written when the file is closed */
+    std::map<std::uint64_t, FunctionResults> mFunctions;
+    std::vector<Function> mCurrentFunctions;
 };
 
 /// @}
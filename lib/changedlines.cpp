@@ -0,0 +1,185 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "changedlines.h"
+
+#include "path.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <iterator>
+
+/** Path in a "--- " or "+++ " line, without timestamp and quotes */
+static std::string diffPath(std::string path)
+{
+    const std::string::size_type tab = path.find('\t');
+    if (tab != std::string::npos)
+        path.erase(tab);
+    if (path.size() >= 2 && path.front() == '"' && path.back() == '"')
+        path = path.substr(1, path.size() - 2);
+    return path;
+}
+
+/** Parse "<start>[,<count>]" */
+static bool parseRange(const std::string &str, int &start, int &count)
+{
+    const std::string::size_type comma = str.find(',');
+    if (!strToInt(str.substr(0, comma), start))
+        return false;
+    if (comma == std::string::npos) {
+        count = 1;
+        return true;
+    }
+    return strToInt(str.substr(comma + 1), count);
+}
+
+/** Parse "@@ -<start>[,<count>] +<start>[,<count>] @@" */
+static bool parseHunkHeader(const std::string &line, int &oldCount, int &newStart, int &newCount)
+{
+    const std::string::size_type minus = line.find(" -");
+    const std::string::size_type plus = line.find(" +");
+    if (minus == std::string::npos || plus == std::string::npos || plus < minus)
+        return false;
+    const std::string::size_type end = line.find(' ', plus + 2);
+    if (end == std::string::npos)
+        return false;
+    int oldStart = 0;
+    return parseRange(line.substr(minus + 2, plus - minus - 2), oldStart, oldCount) &&
+           parseRange(line.substr(plus + 2, end - plus - 2), newStart, newCount) &&
+           oldCount >= 0 && newCount >= 0;
+}
+
+std::string ChangedLines::parseDiff(std::istream &istr)
+{
+    std::string oldFile;
+    std::string file;
+    bool hasFile = false;
+    int newLine = 0;
+    // lines left in the current hunk
+    int oldCount = 0;
+    int newCount = 0;
+
+    std::string line;
+    while (std::getline(istr, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        if (oldCount > 0 || newCount > 0) {
+            // some tools drop the space of empty context lines
+            const char c = line.empty() ? ' ' : line[0];
+            if (c == '+') {
+                add(file, newLine, newLine);
+                ++newLine;
+                --newCount;
+            } else if (c == '-') {
+                add(file, newLine, newLine);
+                --oldCount;
+            } else if (c != '\\') { // "\ No newline at end of file"
+                ++newLine;
+                --oldCount;
+                --newCount;
+            }
+            continue;
+        }
+
+        if (startsWith(line, "--- ")) {
+            oldFile = diffPath(line.substr(4));
+        } else if (startsWith(line, "+++ ")) {
+            file = diffPath(line.substr(4));
+            if (file == "/dev/null")
+                file.clear(); // removed file
+            else if (startsWith(file, "b/") && (startsWith(oldFile, "a/") || oldFile == "/dev/null"))
+                file.erase(0, 2); // git prefix
+            hasFile = true;
+        } else if (startsWith(line, "@@ ")) {
+            if (!hasFile)
+                return "hunk without file in diff: '" + line + "'";
+            if (!parseHunkHeader(line, oldCount, newLine, newCount))
+                return "invalid hunk header in diff: '" + line + "'";
+        }
+        // anything else (git headers, commit messages) is skipped
+    }
+
+    return "";
+}
+
+void ChangedLines::add(const std::string &path, int first, int last)
+{
+    if (path.empty())
+        return;
+    first = std::max(first, 1);
+    last = std::max(last, first);
+
+    Ranges &ranges = mFiles[Path::simplifyPath(Path::fromNativeSeparators(path))];
+    auto it = std::lower_bound(ranges.begin(), ranges.end(), std::make_pair(first, last));
+    it = ranges.emplace(it, first, last);
+
+    // merge with the adjacent ranges
+    if (it != ranges.begin() && std::prev(it)->second + 1 >= it->first) {
+        std::prev(it)->second = std::max(std::prev(it)->second, it->second);
+        it = std::prev(ranges.erase(it));
+    }
+    while (std::next(it) != ranges.end() && it->second + 1 >= std::next(it)->first) {
+        it->second = std::max(it->second, std::next(it)->second);
+        ranges.erase(std::next(it));
+    }
+}
+
+const ChangedLines::Ranges *ChangedLines::findFile(const std::string &path) const
+{
+    const std::string p = Path::simplifyPath(Path::fromNativeSeparators(path));
+    const auto it = mFiles.find(p);
+    if (it != mFiles.end())
+        return &it->second;
+
+    // the diff and the checked files may be relative to different directories
+    const auto isSuffix = [](const std::string &str, const std::string &suffix) {
+        return str.size() > suffix.size() && str[str.size() - suffix.size() - 1] == '/' &&
+               str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    for (const auto &f : mFiles) {
+        if (isSuffix(p, f.first) || isSuffix(f.first, p))
+            return &f.second;
+    }
+    return nullptr;
+}
+
+bool ChangedLines::hasFile(const std::string &path) const
+{
+    return findFile(path) != nullptr;
+}
+
+bool ChangedLines::isChanged(const std::string &path, int first, int last) const
+{
+    const Ranges *ranges = findFile(path);
+    if (!ranges)
+        return false;
+    return std::any_of(ranges->cbegin(), ranges->cend(), [&](const std::pair<int, int> &range) {
+        return range.first <= last && first <= range.second;
+    });
+}
+
+void ChangedLines::dump(std::ostream &out) const
+{
+    for (const auto &f : mFiles) {
+        out << f.first;
+        for (const auto &range : f.second)
+            out << ' ' << range.first << '-' << range.second;
+        out << '\n';
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+//---------------------------------------------------------------------------
+#ifndef changedlinesH
+#define changedlinesH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/** @brief The lines a unified diff adds or modifies, per file (--diff) */
+class CPPCHECKLIB ChangedLines {
+public:
+    /**
+     * @brief Read the changed lines from a unified diff. Removed lines mark
+     * the line that follows them in the new file as changed.
+     * @param istr the diff
+     * @return error message. empty upon success
+     */
+    std::string parseDiff(std::istream &istr);
+
+    /** @brief Add a range of changed lines */
+    void add(const std::string &path, int first, int last);
+
+    bool empty() const {
+        return mFiles.empty();
+    }
+
+    /**
+     * @brief Is the file part of the diff? Paths match if they are equal
+     * or if one of them ends with the other one.
+     */
+    bool hasFile(const std::string &path) const;
+
+    /** @brief Is any line in [first, last] of the file changed? */
+    bool isChanged(const std::string &path, int first, int last) const;
+
+    /** @brief Write the changed lines, for the analyzer information hash */
+    void dump(std::ostream &out) const;
+
+private:
+    using Ranges = std::vector<std::pair<int, int>>;
+
+    const Ranges *findFile(const std::string &path) const;
+
+    /** sorted ranges of changed lines by simplified path */
+    std::map<std::string, Ranges> mFiles;
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // changedlinesH
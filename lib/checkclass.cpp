@@ -729,7 +729,7 @@ bool CheckClass::isBaseClassMutableMemberFunc(const Token *tok, const Scope *sco
 
         // Check if base class exists in database
         if (derivedFrom && derivedFrom->classScope) {
-            const std::list<Function>& functionList = derivedFrom->classScope->functionList;
+            const StableVector<Function>& functionList = derivedFrom->classScope->functionList;
 
             if (std::any_of(functionList.cbegin(), functionList.cend(), [&](const Function& func) {
                 return func.tokenDef->str() == tok->str() && !func.isStatic() && !func.isConst();
@@ -1230,7 +1230,7 @@ static bool checkFunctionUsage(const Function *privfunc, const Scope* scope)
     if (!scope)
         return true; // Assume it is used, if scope is not seen
 
-    for (std::list<Function>::const_iterator func = scope->functionList.cbegin(); func != scope->functionList.cend(); ++func) {
+    for (StableVector<Function>::const_iterator func = scope->functionList.cbegin(); func != scope->functionList.cend(); ++func) {
         if (func->functionScope) {
             if (Token::Match(func->tokenDef, "%name% (")) {
                 for (const Token *ftok = func->tokenDef->tokAt(2); ftok && ftok->str() != ")"; ftok = ftok->next()) {
@@ -1576,7 +1576,7 @@ void CheckClass::operatorEqRetRefThis()
     logChecker("CheckClass::operatorEqRetRefThis"); // style
 
     for (const Scope * scope : mSymbolDatabase->classAndStructScopes) {
-        for (std::list<Function>::const_iterator func = scope->functionList.cbegin(); func != scope->functionList.cend(); ++func) {
+        for (StableVector<Function>::const_iterator func = scope->functionList.cbegin(); func != scope->functionList.cend(); ++func) {
             if (func->type == Function::eOperatorEqual && func->hasBody()) {
                 // make sure return signature is correct
                 if (func->retType == func->nestedIn->definedType && func->tokenDef->strAt(-1) == "&") {
@@ -1624,7 +1624,7 @@ void CheckClass::checkReturnPtrThis(const Scope *scope, const Function *func, co
         if (tok->strAt(2) == "(" &&
             tok->linkAt(2)->strAt(1) == ";") {
             // check if it is a member function
-            for (std::list<Function>::const_iterator it = scope->functionList.cbegin(); it != scope->functionList.cend(); ++it) {
+            for (StableVector<Function>::const_iterator it = scope->functionList.cbegin(); it != scope->functionList.cend(); ++it) {
                 // check for a regular function with the same name and a body
                 if (it->type == Function::eFunction && it->hasBody() &&
                     it->token->str() == tok->strAt(1)) {
@@ -2211,6 +2211,29 @@ static const Token* getFuncTokFromThis(const Token* tok) {
     return Token::Match(tok, "%name% (") ? tok : nullptr;
 }
 
+const CheckClass::MemberNames& CheckClass::getMemberNames(const Scope *scope) const
+{
+    const auto it = mMemberNames.find(scope);
+    if (it != mMemberNames.end())
+        return it->second;
+
+    // insert before recursing so that cyclic inheritance terminates
+    MemberNames& names = mMemberNames[scope];
+    for (const Variable& var : scope->varlist) {
+        names.vars[var.name()].push_back(&var);
+        names.allVars.insert(var.name());
+    }
+    if (scope->definedType) {
+        for (const Type::BaseInfo & i : scope->definedType->derivedFrom) {
+            if (i.type && i.type->classScope && i.type->classScope != scope) {
+                const MemberNames& baseNames = getMemberNames(i.type->classScope);
+                names.allVars.insert(baseNames.allVars.cbegin(), baseNames.allVars.cend());
+            }
+        }
+    }
+    return names;
+}
+
 bool CheckClass::isMemberVar(const Scope *scope, const Token *tok) const
 {
     bool again = false;
@@ -2241,8 +2264,13 @@ bool CheckClass::isMemberVar(const Scope *scope, const Token *tok) const
     if (tok->isKeyword() || tok->isStandardType())
         return false;
 
-    for (const Variable& var : scope->varlist) {
-        if (var.name() == tok->str()) {
+    const MemberNames& names = getMemberNames(scope);
+    if (names.allVars.count(tok->str()) == 0)
+        return false;
+
+    const auto varsIt = names.vars.find(tok->str());
+    if (varsIt != names.vars.end()) {
+        for (const Variable* var : varsIt->second) {
             if (Token::Match(tok, "%name% ::"))
                 continue;
             const Token* fqTok = tok;
@@ -2263,7 +2291,7 @@ bool CheckClass::isMemberVar(const Scope *scope, const Token *tok) const
                 if (tok->varId() == 0)
                     mSymbolDatabase->debugMessage(tok, "varid0", "CheckClass::isMemberVar found used member variable \'" + tok->str() + "\' with varid 0");
 
-                return !var.isStatic();
+                return !var->isStatic();
             }
         }
     }
@@ -2289,22 +2317,22 @@ bool CheckClass::isMemberVar(const Scope *scope, const Token *tok) const
 bool CheckClass::isMemberFunc(const Scope *scope, const Token *tok)
 {
     if (!tok->function()) {
-        for (const Function &func : scope->functionList) {
-            if (func.name() == tok->str()) {
-                const Token* tok2 = tok->tokAt(2);
-                int argsPassed = tok2->str() == ")" ? 0 : 1;
-                for (;;) {
-                    tok2 = tok2->nextArgument();
-                    if (tok2)
-                        argsPassed++;
-                    else
-                        break;
-                }
-                if (argsPassed == func.argCount() ||
-                    (func.isVariadic() && argsPassed >= (func.argCount() - 1)) ||
-                    (argsPassed < func.argCount() && argsPassed >= func.minArgCount()))
-                    return true;
+        const auto range = scope->functionMap.equal_range(tok->str());
+        for (auto it = range.first; it != range.second; ++it) {
+            const Function &func = *it->second;
+            const Token* tok2 = tok->tokAt(2);
+            int argsPassed = tok2->str() == ")" ? 0 : 1;
+            for (;;) {
+                tok2 = tok2->nextArgument();
+                if (tok2)
+                    argsPassed++;
+                else
+                    break;
             }
+            if (argsPassed == func.argCount() ||
+                (func.isVariadic() && argsPassed >= (func.argCount() - 1)) ||
+                (argsPassed < func.argCount() && argsPassed >= func.minArgCount()))
+                return true;
         }
     } else if (tok->function()->nestedIn == scope)
         return !tok->function()->isStatic();
@@ -2662,7 +2690,7 @@ void CheckClass::initializerListOrder()
     for (const Scope * scope : mSymbolDatabase->classAndStructScopes) {
 
         // iterate through all member functions looking for constructors
-        for (std::list<Function>::const_iterator func = scope->functionList.cbegin(); func != scope->functionList.cend(); ++func) {
+        for (StableVector<Function>::const_iterator func = scope->functionList.cbegin(); func != scope->functionList.cend(); ++func) {
             if (func->isConstructor() && func->hasBody()) {
                 // check for initializer list
                 const Token *tok = func->arg->link()->next();
@@ -31,6 +31,8 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 class ErrorLogger;
@@ -305,6 +307,15 @@ private:
     static const Token * getIfStmtBodyStart(const Token *tok, const Token *rhs);
 
     // checkConst helper functions
+    /** @brief Member variable names of a class scope. Built once per scope and reused by isMemberVar() */
+    struct MemberNames {
+        /** member variables declared in the scope itself, in declaration order */
+        std::unordered_map<std::string, std::vector<const Variable*>> vars;
+        /** names of all member variables, including those of base classes */
+        std::unordered_set<std::string> allVars;
+    };
+    const MemberNames& getMemberNames(const Scope *scope) const;
+    mutable std::unordered_map<const Scope*, MemberNames> mMemberNames;
     bool isMemberVar(const Scope *scope, const Token *tok) const;
     static bool isMemberFunc(const Scope *scope, const Token *tok);
     static bool isConstMemberFunc(const Scope *scope, const Token *tok);
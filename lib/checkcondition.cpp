@@ -266,11 +266,11 @@ void CheckCondition::mismatchingBitAndError(const Token *tok1, const MathLib::bi
 static void getnumchildren(const Token *tok, std::list<MathLib::bigint> &numchildren)
 {
     if (tok->astOperand1() && tok->astOperand1()->isNumber())
-        numchildren.push_back(MathLib::toBigNumber(tok->astOperand1()->str()));
+        numchildren.push_back(tok->astOperand1()->getIntNumber());
     else if (tok->astOperand1() && tok->str() == tok->astOperand1()->str())
         getnumchildren(tok->astOperand1(), numchildren);
     if (tok->astOperand2() && tok->astOperand2()->isNumber())
-        numchildren.push_back(MathLib::toBigNumber(tok->astOperand2()->str()));
+        numchildren.push_back(tok->astOperand2()->getIntNumber());
     else if (tok->astOperand2() && tok->str() == tok->astOperand2()->str())
         getnumchildren(tok->astOperand2(), numchildren);
 }
@@ -371,7 +371,7 @@ void CheckCondition::comparison()
             std::swap(expr1,expr2);
         if (!expr2->isNumber())
             continue;
-        const MathLib::bigint num2 = MathLib::toBigNumber(expr2->str());
+        const MathLib::bigint num2 = expr2->getIntNumber();
         if (num2 < 0)
             continue;
         if (!Token::Match(expr1,"[&|]"))
@@ -461,8 +461,8 @@ bool CheckCondition::isOverlappingCond(const Token * const cond1, const Token *
         if (!isSameExpression(true, expr1, expr2, *mSettings, pure, false))
             return false;
 
-        const MathLib::bigint value1 = MathLib::toBigNumber(num1->str());
-        const MathLib::bigint value2 = MathLib::toBigNumber(num2->str());
+        const MathLib::bigint value1 = num1->getIntNumber();
+        const MathLib::bigint value2 = num2->getIntNumber();
         if (cond2->str() == "&")
             return ((value1 & value2) == value2);
         return ((value1 & value2) > 0);
@@ -600,6 +600,57 @@ void CheckIO::checkWrongPrintfScanfArguments()
     }
 }
 
+std::vector<CheckIO::FormatSpecifier> CheckIO::parseFormatString(const std::string &formatString)
+{
+    std::vector<FormatSpecifier> specifiers;
+    bool percent = false;
+    for (std::string::const_iterator i = formatString.cbegin(); i != formatString.cend(); ++i) {
+        if (*i == '%') {
+            percent = !percent;
+        } else if (percent && *i == '[') {
+            FormatSpecifier spec;
+            spec.scanSet = true;
+            while (i != formatString.cend() && *i != ']')
+                ++i;
+            spec.endOfString = i == formatString.cend();
+            if (!spec.endOfString)
+                spec.pos = i - formatString.cbegin();
+            specifiers.push_back(std::move(spec));
+            if (i == formatString.cend())
+                break;
+            percent = false;
+        } else if (percent) {
+            percent = false;
+
+            FormatSpecifier spec;
+            while (i != formatString.cend() && *i != '[' && !std::isalpha((unsigned char)*i)) {
+                if (*i == '*') {
+                    spec.numStars++;
+                } else if (std::isdigit(*i)) {
+                    spec.width += *i;
+                } else if (*i == '$') {
+                    spec.parameterPosition = spec.width;
+                    spec.hasParameterPosition = true;
+                    spec.width.clear();
+                }
+                ++i;
+            }
+            if (i != formatString.cend() && *i == '[') {
+                spec.bracketPos = i - formatString.cbegin();
+                while (i != formatString.cend() && *i != ']')
+                    ++i;
+            }
+            spec.endOfString = i == formatString.cend();
+            if (!spec.endOfString)
+                spec.pos = i - formatString.cbegin();
+            specifiers.push_back(std::move(spec));
+            if (i == formatString.cend())
+                break;
+        }
+    }
+    return specifiers;
+}
+
 void CheckIO::checkFormatString(const Token * const tok,
                                 const Token * const formatStringTok,
                                 const Token *       argListTok,
@@ -613,22 +664,17 @@ void CheckIO::checkFormatString(const Token * const tok,
     // Count format string parameters..
     int numFormat = 0;
     int numSecure = 0;
-    bool percent = false;
     const Token* argListTok2 = argListTok;
     std::set<int> parameterPositionsUsed;
-    for (std::string::const_iterator i = formatString.cbegin(); i != formatString.cend(); ++i) {
-        if (*i == '%') {
-            percent = !percent;
-        } else if (percent && *i == '[') {
-            while (i != formatString.cend()) {
-                if (*i == ']') {
-                    numFormat++;
-                    if (argListTok)
-                        argListTok = argListTok->nextArgument();
-                    percent = false;
-                    break;
-                }
-                ++i;
+    auto specifiers = mFormatSpecifiers.find(formatString);
+    if (specifiers == mFormatSpecifiers.end())
+        specifiers = mFormatSpecifiers.emplace(formatString, parseFormatString(formatString)).first;
+    for (const FormatSpecifier &spec : specifiers->second) {
+        if (spec.scanSet) {
+            if (!spec.endOfString) {
+                numFormat++;
+                if (argListTok)
+                    argListTok = argListTok->nextArgument();
             }
             if (scanf_s) {
                 numSecure++;
@@ -636,61 +682,35 @@ void CheckIO::checkFormatString(const Token * const tok,
                     argListTok = argListTok->nextArgument();
                 }
             }
-            if (i == formatString.cend())
-                break;
-        } else if (percent) {
-            percent = false;
-
-            bool _continue = false;
-            bool skip = false;
-            std::string width;
-            int parameterPosition = 0;
-            bool hasParameterPosition = false;
-            while (i != formatString.cend() && *i != '[' && !std::isalpha((unsigned char)*i)) {
-                if (*i == '*') {
-                    skip = true;
-                    if (scan)
-                        _continue = true;
-                    else {
-                        numFormat++;
-                        if (argListTok)
-                            argListTok = argListTok->nextArgument();
-                    }
-                } else if (std::isdigit(*i)) {
-                    width += *i;
-                } else if (*i == '$') {
-                    parameterPosition = strToInt<int>(width);
-                    hasParameterPosition = true;
-                    width.clear();
+        } else {
+            const int parameterPosition = spec.hasParameterPosition ? strToInt<int>(spec.parameterPosition) : 0;
+            const bool skip = spec.numStars > 0;
+            if (!scan) {
+                for (int star = 0; star < spec.numStars; ++star) {
+                    numFormat++;
+                    if (argListTok)
+                        argListTok = argListTok->nextArgument();
                 }
-                ++i;
             }
-            auto bracketBeg = formatString.cend();
-            if (i != formatString.cend() && *i == '[') {
-                bracketBeg = i;
-                while (i != formatString.cend()) {
-                    if (*i == ']')
-                        break;
-
-                    ++i;
-                }
-                if (scanf_s && !skip) {
-                    numSecure++;
-                    if (argListTok) {
-                        argListTok = argListTok->nextArgument();
-                    }
+            if (spec.bracketPos != std::string::npos && scanf_s && !skip) {
+                numSecure++;
+                if (argListTok) {
+                    argListTok = argListTok->nextArgument();
                 }
             }
-            if (i == formatString.cend())
+            if (spec.endOfString)
                 break;
-            if (_continue)
+            if (scan && skip)
                 continue;
 
+            const std::string &width = spec.width;
+            std::string::const_iterator i = formatString.cbegin() + spec.pos;
+            const auto bracketBeg = spec.bracketPos != std::string::npos ? formatString.cbegin() + spec.bracketPos : formatString.cend();
             if (scan || *i != 'm') { // %m is a non-standard extension that requires no parameter on print functions.
                 ++numFormat;
 
                 // Handle parameter positions (POSIX extension) - Ticket #4900
-                if (hasParameterPosition) {
+                if (spec.hasParameterPosition) {
                     if (parameterPositionsUsed.find(parameterPosition) == parameterPositionsUsed.end())
                         parameterPositionsUsed.insert(parameterPosition);
                     else // Parameter already referenced, hence don't consider it a new format
@@ -28,6 +28,8 @@
 #include <cstdint>
 #include <ostream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class Function;
 class Settings;
@@ -99,6 +101,31 @@ private:
         bool isCPP{};
     };
 
+    /** @brief A conversion specification in a format string */
+    struct FormatSpecifier {
+        /** offset of the conversion character (']' for scan sets) */
+        std::string::size_type pos{};
+        /** offset of '[' if the conversion is a scan set with flags or width, npos otherwise */
+        std::string::size_type bracketPos = std::string::npos;
+        /** width, digits given before the conversion */
+        std::string width;
+        /** digits given before '$' (POSIX parameter position) */
+        std::string parameterPosition;
+        bool hasParameterPosition{};
+        /** number of '*' given before the conversion */
+        int numStars{};
+        /** "%[...]" without flags or width */
+        bool scanSet{};
+        /** the format string ends before the conversion is complete */
+        bool endOfString{};
+    };
+
+    /** @brief Split a format string into its conversion specifications */
+    static std::vector<FormatSpecifier> parseFormatString(const std::string &formatString);
+
+    /** @brief parsed format strings, see parseFormatString() */
+    std::unordered_map<std::string, std::vector<FormatSpecifier>> mFormatSpecifiers;
+
     void checkFormatString(const Token * const tok,
                            const Token * const formatStringTok,
                            const Token *       argListTok,
@@ -487,7 +487,7 @@ void CheckOther::checkRedundantAssignment()
                     // If there is a custom assignment operator => this is inconclusive
                     if (tok->astOperand1()->valueType()->typeScope) {
                         const std::string op = "operator" + tok->str();
-                        const std::list<Function>& fList = tok->astOperand1()->valueType()->typeScope->functionList;
+                        const StableVector<Function>& fList = tok->astOperand1()->valueType()->typeScope->functionList;
                         inconclusive = std::any_of(fList.cbegin(), fList.cend(), [&](const Function& f) {
                             return f.name() == op;
                         });
@@ -499,7 +499,7 @@ void CheckOther::checkRedundantAssignment()
                 if (inconclusive && !mSettings->certainty.isEnabled(Certainty::inconclusive))
                     continue;
 
-                FwdAnalysis fwdAnalysis(*mSettings);
+                FwdAnalysis fwdAnalysis(*mSettings, *symbolDatabase);
                 if (fwdAnalysis.hasOperand(tok->astOperand2(), tok->astOperand1()))
                     continue;
 
@@ -3664,17 +3664,18 @@ static const Token *findShadowed(const Scope *scope, const Variable& var, int li
 {
     if (!scope)
         return nullptr;
-    for (const Variable &v : scope->varlist) {
-        if (scope->isExecutable() && v.nameToken()->linenr() > linenr)
+    const auto vars = scope->varMap.equal_range(var.name());
+    for (auto it = vars.first; it != vars.second; ++it) {
+        if (scope->isExecutable() && it->second->nameToken()->linenr() > linenr)
             continue;
-        if (v.name() == var.name())
-            return v.nameToken();
+        return it->second->nameToken();
+    }
+    const auto functions = scope->functionMap.equal_range(var.name());
+    for (auto it = functions.first; it != functions.second; ++it) {
+        const Function *f = it->second;
+        if (f->type == Function::Type::eFunction && precedes(f->tokenDef, var.nameToken()))
+            return f->tokenDef;
     }
-    auto it = std::find_if(scope->functionList.cbegin(), scope->functionList.cend(), [&](const Function& f) {
-        return f.type == Function::Type::eFunction && f.name() == var.name() && precedes(f.tokenDef, var.nameToken());
-    });
-    if (it != scope->functionList.end())
-        return it->tokenDef;
 
     if (scope->type == Scope::eLambda)
         return nullptr;
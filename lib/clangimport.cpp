@@ -675,12 +675,20 @@ Scope *clangimport::AstNode::createScope(TokenList &tokenList, Scope::ScopeType
                 const Variable *from = vartok->variable();
                 scope->varlist.emplace_back(*from, scope);
                 Variable *to = &scope->varlist.back();
+                scope->varMap.insert(std::make_pair(to->name(), to));
                 replaceVar[from] = to;
                 mData->replaceVarDecl(from, to);
             }
             if (replaceVar.find(vartok->variable()) != replaceVar.end())
                 const_cast<Token *>(vartok)->variable(replaceVar[vartok->variable()]);
         }
+        std::multimap<std::string, const Variable *> &varMap = const_cast<Scope *>(def->scope())->varMap;
+        for (std::multimap<std::string, const Variable *>::iterator var = varMap.begin(); var != varMap.end();) {
+            if (replaceVar.find(var->second) != replaceVar.end())
+                var = varMap.erase(var);
+            else
+                ++var;
+        }
         std::list<Variable> &varlist = const_cast<Scope *>(def->scope())->varlist;
         for (std::list<Variable>::iterator var = varlist.begin(); var != varlist.end();) {
             if (replaceVar.find(&(*var)) != replaceVar.end())
@@ -1342,6 +1350,7 @@ void clangimport::AstNode::createTokensFunctionDecl(TokenList &tokenList)
     }
     if (!nameToken->function()) {
         nestedIn->functionList.emplace_back(nameToken, unquote(getFullType()));
+        nestedIn->functionMap.insert(std::make_pair(nameToken->str(), &nestedIn->functionList.back()));
         mData->funcDecl(mExtTokens.front(), nameToken, &nestedIn->functionList.back());
         if (nodeType == CXXConstructorDecl)
             nestedIn->functionList.back().type = Function::Type::eConstructor;
@@ -1496,6 +1505,7 @@ Token * clangimport::AstNode::createTokensVarDecl(TokenList &tokenList)
     Token *vartok1 = addtoken(tokenList, name);
     auto *scope = const_cast<Scope *>(tokenList.back()->scope());
     scope->varlist.emplace_back(vartok1, unquote(type), startToken, vartok1->previous(), 0, scope->defaultAccess(), recordType, scope);
+    scope->varMap.insert(std::make_pair(vartok1->str(), &scope->varlist.back()));
     mData->varDecl(addr, vartok1, &scope->varlist.back());
     if (mExtTokens.back() == "cinit" && !children.empty()) {
         Token *eq = addtoken(tokenList, "=");
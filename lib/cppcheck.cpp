@@ -27,6 +27,7 @@
 #include "errortypes.h"
 #include "filesettings.h"
 #include "library.h"
+#include "memoryusage.h"
 #include "path.h"
 #include "platform.h"
 #include "preprocessor.h"
@@ -71,6 +72,10 @@
 #define PCRE_STATIC
 #endif
 #include <pcre.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
 #endif
 
 class SymbolDatabase;
@@ -100,6 +105,41 @@ namespace {
     private:
         std::vector<std::string> mFilenames;
     };
+
+    /**
+     * Counts the heap usage of a file during its analysis (--showmemory, --max-memory-per-file)
+     * and reports the heap high-water marks when it is done (--showmemory)
+     */
+    class FileMemoryUsage {
+    public:
+        FileMemoryUsage(const Settings &settings, ErrorLogger &errorLogger, std::string file)
+            : mEnabled(settings.showmemory || (settings.maxMemoryPerFile > 0 && MemoryUsage::isHooked()))
+            , mReport(settings.showmemory)
+            , mErrorLogger(errorLogger)
+            , mFile(std::move(file)) {
+            if (mEnabled) {
+                MemoryUsage::setCounting(true);
+                MemoryUsage::startFile(static_cast<std::int64_t>(settings.maxMemoryPerFile) * 1024 * 1024);
+            }
+        }
+        ~FileMemoryUsage() {
+            if (!mEnabled)
+                return;
+            MemoryUsage::FileResults results = MemoryUsage::stopFile(mFile);
+            if (!mReport)
+                return;
+            mErrorLogger.reportOut(results.toString(5));
+            MemoryUsage::addResults(std::move(results));
+        }
+
+        FileMemoryUsage(const FileMemoryUsage&) = delete;
+        FileMemoryUsage& operator=(const FileMemoryUsage&) = delete;
+    private:
+        const bool mEnabled;
+        const bool mReport;
+        ErrorLogger &mErrorLogger;
+        const std::string mFile;
+    };
 }
 
 static std::string cmdFileName(std::string f)
@@ -613,6 +653,7 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
         return mExitCode;
 
     const Timer fileTotalTimer(mSettings.showtime == SHOWTIME_MODES::SHOWTIME_FILE_TOTAL, file.spath());
+    const FileMemoryUsage fileMemoryUsage(mSettings, mErrorLogger, file.spath());
 
     if (!mSettings.quiet) {
         std::string fixedpath = Path::toNativeSeparators(file.spath());
@@ -718,6 +759,12 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
         tokens1.removeComments();
         preprocessor.removeComments();
 
+        // --function-cache: the bodies of removed functions would change the dump, the
+        // unused functions and the results of the addons
+        const bool useFunctionCache = mSettings.functionCache && !mSettings.buildDir.empty() && !mSettings.dump &&
+                                      mSettings.addons.empty() && !mSettings.checks.isEnabled(Checks::unusedFunction);
+        std::uint64_t toolinfoHash = 0;
+
         if (!mSettings.buildDir.empty()) {
             // Get toolinfo
             std::ostringstream toolinfo;
@@ -729,9 +776,11 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
             toolinfo << (mSettings.severity.isEnabled(Severity::information) ? 'i' : ' ');
             toolinfo << mSettings.userDefines;
             mSettings.supprs.nomsg.dump(toolinfo);
+            mSettings.diff.dump(toolinfo);
 
             // Calculate hash so it can be compared with old hash / future hashes
-            const std::size_t hash = preprocessor.calculateHash(tokens1, toolinfo.str());
+            const std::uint64_t hash = preprocessor.calculateHash(tokens1, toolinfo.str());
+            toolinfoHash = StableHash().update(toolinfo.str()).digest();
             std::list<ErrorMessage> errors;
             if (!mAnalyzerInformation.analyzeFile(mSettings.buildDir, file.spath(), cfgname, hash, errors)) {
                 while (!errors.empty()) {
@@ -753,6 +802,7 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
             if (!mSettings.dump)
                 filesDeleter.addFile(dumpFile);
         }
+        std::string().swap(dumpProlog);
 
         // Get directives
         std::list<Directive> directives = preprocessor.createDirectives(tokens1);
@@ -809,6 +859,10 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
             if (Settings::terminated())
                 break;
 
+            // bail out if the memory limit of the file has been exceeded
+            if (MemoryUsage::limitExceeded())
+                break;
+
             // Check only a few configurations (default 12), after that bail out, unless --force
             // was used.
             if (!mSettings.force && ++checkCount > mSettings.maxConfigs)
@@ -846,16 +900,27 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
                 continue;
             }
 
+            // The raw tokens, the included files and the directives are released when
+            // the last configuration has been preprocessed
+            const bool lastConfiguration = &currCfg == &*configurations.crbegin() ||
+                                           (!mSettings.force && checkCount == mSettings.maxConfigs);
+
             Tokenizer tokenizer(mSettings, *this);
-            if (mSettings.showtime != SHOWTIME_MODES::SHOWTIME_NONE)
+            if (mSettings.showtime != SHOWTIME_MODES::SHOWTIME_NONE || mSettings.showmemory)
                 tokenizer.setTimerResults(&s_timerResults);
-            tokenizer.setDirectives(directives); // TODO: how to avoid repeated copies?
 
             try {
                 // Create tokens, skip rest of iteration if failed
                 {
                     Timer timer("Tokenizer::createTokens", mSettings.showtime, &s_timerResults);
                     simplecpp::TokenList tokensP = preprocessor.preprocess(tokens1, mCurrentConfig, files, true);
+                    if (lastConfiguration) {
+                        tokens1.clear();
+                        preprocessor.clearFiles();
+                        tokenizer.setDirectives(std::move(directives));
+                    } else {
+                        tokenizer.setDirectives(directives); // TODO: how to avoid repeated copies?
+                    }
                     tokenizer.list.createTokens(std::move(tokensP));
                 }
                 hasValidConfig = true;
@@ -885,10 +950,33 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
                 executeRules("raw", tokenizer.list);
 #endif
 
+                const auto functionHash = [&](const Tokenizer::FunctionBody &body) {
+                    return StableHash(toolinfoHash).update(body.hash).digest();
+                };
+                if (useFunctionCache) {
+                    tokenizer.setKnownFunctionResults([&](const Tokenizer::FunctionBody &body) {
+                        return mAnalyzerInformation.hasFunctionResults(functionHash(body));
+                    });
+                }
+
                 // Simplify tokens into normal form, skip rest of iteration if failed
                 if (!tokenizer.simplifyTokens1(mCurrentConfig))
                     continue;
 
+                // Report the known findings of the removed function bodies
+                if (useFunctionCache) {
+                    std::vector<AnalyzerInformation::Function> functions;
+                    for (const Tokenizer::FunctionBody &body : tokenizer.functionBodies())
+                        functions.push_back(AnalyzerInformation::Function{body.file, body.first, body.last, functionHash(body)});
+                    mAnalyzerInformation.setFunctions(functions);
+                    for (std::size_t i = 0; i < functions.size(); ++i) {
+                        if (!tokenizer.functionBodies()[i].removed)
+                            continue;
+                        for (const ErrorMessage &msg : mAnalyzerInformation.getFunctionResults(functions[i]))
+                            reportErr(msg);
+                    }
+                }
+
                 // dump xml if --dump
                 if ((mSettings.dump || !mSettings.addons.empty()) && fdump.is_open()) {
                     fdump << "<dump cfg=\"" << ErrorLogger::toxml(mCurrentConfig) << "\">" << std::endl;
@@ -906,7 +994,7 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
 
                 // Skip if we already met the same simplified token list
                 if (mSettings.force || mSettings.maxConfigs > 1) {
-                    const std::size_t hash = tokenizer.list.calculateHash();
+                    const std::uint64_t hash = tokenizer.list.calculateHash();
                     if (hashes.find(hash) != hashes.end()) {
                         if (mSettings.debugwarnings)
                             purgedConfigurationMessage(file.spath(), mCurrentConfig);
@@ -968,6 +1056,9 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
             reportErr(errmsg);
         }
 
+        if (MemoryUsage::limitExceeded())
+            memoryLimitMessage(file.spath());
+
         // dumped all configs, close root </dumps> element now
         if (fdump.is_open()) {
             fdump << "</dumps>" << std::endl;
@@ -982,7 +1073,10 @@ unsigned int CppCheck::checkFile(const FileWithDetails& file, const std::string
     } catch (const std::runtime_error &e) {
         internalError(file.spath(), std::string("Checking file failed: ") + e.what());
     } catch (const std::bad_alloc &) {
-        internalError(file.spath(), "Checking file failed: out of memory");
+        if (mSettings.maxMemoryPerFile > 0)
+            internalError(file.spath(), "Checking file failed: out of memory (--max-memory-per-file=" + std::to_string(mSettings.maxMemoryPerFile) + ")");
+        else
+            internalError(file.spath(), "Checking file failed: out of memory");
     } catch (const InternalError &e) {
         const ErrorMessage errmsg = ErrorMessage::fromInternalError(e, nullptr, file.spath(), "Bailing out from analysis: Checking file failed");
         reportErr(errmsg);
@@ -1044,6 +1138,9 @@ void CppCheck::checkNormalTokens(const Tokenizer &tokenizer)
             if (Settings::terminated())
                 return;
 
+            if (MemoryUsage::limitExceeded())
+                return;
+
             if (maxTime > 0 && std::time(nullptr) > maxTime) {
                 if (mSettings.debugwarnings) {
                     ErrorMessage::FileLocation loc(tokenizer.list.getFiles()[0], 0, 0);
@@ -1250,17 +1347,92 @@ static const char * pcreErrorCodeToString(const int pcreExecRet)
     return "";
 }
 
+namespace {
+    /** @brief A rule pattern compiled (and JIT-studied) by pcre */
+    struct CompiledRule {
+        CompiledRule() = default;
+        CompiledRule(const CompiledRule &) = delete;
+        CompiledRule &operator=(const CompiledRule &) = delete;
+        ~CompiledRule() {
+#ifdef PCRE_CONFIG_JIT
+            // Free up the EXTRA PCRE value (may be NULL at this point)
+            if (extra)
+                pcre_free_study(extra);
+#endif
+            if (re)
+                pcre_free(re);
+        }
+
+        pcre *re{};
+        pcre_extra *extra{};
+        /** id and message of the error that occurred while compiling, if any */
+        std::string errorId;
+        std::string errorMsg;
+    };
+}
+
+/**
+ * Get the compiled form of a rule pattern. Patterns are compiled on first
+ * use and then shared by all CppCheck instances (files and threads) of the
+ * process, since compiling and JIT-studying a pattern costs far more than
+ * matching it against a single translation unit.
+ */
+static const CompiledRule &getCompiledRule(const std::string &pattern)
+{
+    static std::mutex compiledRulesSync;
+    static std::map<std::string, std::unique_ptr<CompiledRule>> compiledRules;
+
+    std::lock_guard<std::mutex> lg(compiledRulesSync);
+    std::unique_ptr<CompiledRule> &compiledRule = compiledRules[pattern];
+    if (compiledRule)
+        return *compiledRule;
+    compiledRule.reset(new CompiledRule);
+
+    const char *pcreCompileErrorStr = nullptr;
+    int erroffset = 0;
+    compiledRule->re = pcre_compile(pattern.c_str(),0,&pcreCompileErrorStr,&erroffset,nullptr);
+    if (!compiledRule->re) {
+        if (pcreCompileErrorStr) {
+            compiledRule->errorId = "pcre_compile";
+            compiledRule->errorMsg = "pcre_compile failed: " + std::string(pcreCompileErrorStr);
+        }
+        return *compiledRule;
+    }
+
+    // Optimize the regex, but only if PCRE_CONFIG_JIT is available
+#ifdef PCRE_CONFIG_JIT
+    const char *pcreStudyErrorStr = nullptr;
+    compiledRule->extra = pcre_study(compiledRule->re, PCRE_STUDY_JIT_COMPILE, &pcreStudyErrorStr);
+    // pcre_study() returns NULL for both errors and when it can not optimize the regex.
+    // The last argument is how one checks for errors.
+    // It is NULL if everything works, and points to an error string otherwise.
+    if (pcreStudyErrorStr) {
+        compiledRule->errorId = "pcre_study";
+        compiledRule->errorMsg = "pcre_study failed: " + std::string(pcreStudyErrorStr);
+        // pcre_compile() worked, but pcre_study() returned an error. Free the resources allocated by pcre_compile().
+        pcre_free(compiledRule->re);
+        compiledRule->re = nullptr;
+    }
+#endif
+    return *compiledRule;
+}
+
 void CppCheck::executeRules(const std::string &tokenlist, const TokenList &list)
 {
     // There is no rule to execute
     if (!hasRule(tokenlist))
         return;
 
-    // Write all tokens in a string that can be parsed by pcre
+    // Write all tokens in a string that can be parsed by pcre.
+    // Remember where each token ends so matches can be located without rescanning the list.
     std::string str;
+    std::vector<std::size_t> tokenEnds;
+    std::vector<const Token *> tokens;
     for (const Token *tok = list.front(); tok; tok = tok->next()) {
         str += " ";
         str += tok->str();
+        tokenEnds.push_back(str.size());
+        tokens.push_back(tok);
     }
 
     for (const Settings::Rule &rule : mSettings.rules) {
@@ -1271,17 +1443,14 @@ void CppCheck::executeRules(const std::string &tokenlist, const TokenList &list)
             reportOut("Processing rule: " + rule.pattern, Color::FgGreen);
         }
 
-        const char *pcreCompileErrorStr = nullptr;
-        int erroffset = 0;
-        pcre * const re = pcre_compile(rule.pattern.c_str(),0,&pcreCompileErrorStr,&erroffset,nullptr);
-        if (!re) {
-            if (pcreCompileErrorStr) {
-                const std::string msg = "pcre_compile failed: " + std::string(pcreCompileErrorStr);
+        const CompiledRule &compiledRule = getCompiledRule(rule.pattern);
+        if (!compiledRule.re) {
+            if (!compiledRule.errorMsg.empty()) {
                 const ErrorMessage errmsg(std::list<ErrorMessage::FileLocation>(),
                                           emptyString,
                                           Severity::error,
-                                          msg,
-                                          "pcre_compile",
+                                          compiledRule.errorMsg,
+                                          compiledRule.errorId,
                                           Certainty::normal);
 
                 reportErr(errmsg);
@@ -1289,35 +1458,10 @@ void CppCheck::executeRules(const std::string &tokenlist, const TokenList &list)
             continue;
         }
 
-        // Optimize the regex, but only if PCRE_CONFIG_JIT is available
-#ifdef PCRE_CONFIG_JIT
-        const char *pcreStudyErrorStr = nullptr;
-        pcre_extra * const pcreExtra = pcre_study(re, PCRE_STUDY_JIT_COMPILE, &pcreStudyErrorStr);
-        // pcre_study() returns NULL for both errors and when it can not optimize the regex.
-        // The last argument is how one checks for errors.
-        // It is NULL if everything works, and points to an error string otherwise.
-        if (pcreStudyErrorStr) {
-            const std::string msg = "pcre_study failed: " + std::string(pcreStudyErrorStr);
-            const ErrorMessage errmsg(std::list<ErrorMessage::FileLocation>(),
-                                      emptyString,
-                                      Severity::error,
-                                      msg,
-                                      "pcre_study",
-                                      Certainty::normal);
-
-            reportErr(errmsg);
-            // pcre_compile() worked, but pcre_study() returned an error. Free the resources allocated by pcre_compile().
-            pcre_free(re);
-            continue;
-        }
-#else
-        const pcre_extra * const pcreExtra = nullptr;
-#endif
-
         int pos = 0;
         int ovector[30]= {0};
         while (pos < (int)str.size()) {
-            const int pcreExecRet = pcre_exec(re, pcreExtra, str.c_str(), (int)str.size(), pos, 0, ovector, 30);
+            const int pcreExecRet = pcre_exec(compiledRule.re, compiledRule.extra, str.c_str(), (int)str.size(), pos, 0, ovector, 30);
             if (pcreExecRet < 0) {
                 const std::string errorMessage = pcreErrorCodeToString(pcreExecRet);
                 if (!errorMessage.empty()) {
@@ -1342,14 +1486,11 @@ void CppCheck::executeRules(const std::string &tokenlist, const TokenList &list)
             int fileIndex = 0;
             int line = 0;
 
-            std::size_t len = 0;
-            for (const Token *tok = list.front(); tok; tok = tok->next()) {
-                len = len + 1U + tok->str().size();
-                if (len > pos1) {
-                    fileIndex = tok->fileIndex();
-                    line = tok->linenr();
-                    break;
-                }
+            const auto it = std::upper_bound(tokenEnds.cbegin(), tokenEnds.cend(), (std::size_t)pos1);
+            if (it != tokenEnds.cend()) {
+                const Token *tok = tokens[it - tokenEnds.cbegin()];
+                fileIndex = tok->fileIndex();
+                line = tok->linenr();
             }
 
             const std::string& file = list.getFiles()[fileIndex];
@@ -1367,14 +1508,6 @@ void CppCheck::executeRules(const std::string &tokenlist, const TokenList &list)
             // Report error
             reportErr(errmsg);
         }
-
-        pcre_free(re);
-#ifdef PCRE_CONFIG_JIT
-        // Free up the EXTRA PCRE value (may be NULL at this point)
-        if (pcreExtra) {
-            pcre_free_study(pcreExtra);
-        }
-#endif
     }
 }
 #endif
@@ -1558,6 +1691,24 @@ void CppCheck::purgedConfigurationMessage(const std::string &file, const std::st
     reportErr(errmsg);
 }
 
+void CppCheck::memoryLimitMessage(const std::string &file)
+{
+    std::list<ErrorMessage::FileLocation> loclist;
+    if (!file.empty()) {
+        loclist.emplace_back(file, 0, 0);
+    }
+
+    ErrorMessage errmsg(std::move(loclist),
+                        emptyString,
+                        Severity::information,
+                        "Limiting analysis of file since it uses more than " + std::to_string(mSettings.maxMemoryPerFile) + " MiB of memory. "
+                        "The remaining ValueFlow analysis and checks of the file are skipped. Use --max-memory-per-file to change the limit.",
+                        "maxMemoryPerFile",
+                        Certainty::normal);
+
+    reportErr(errmsg);
+}
+
 //---------------------------------------------------------------------------
 
 // TODO: part of this logic is duplicated in Executor::hasToLog()
@@ -1571,6 +1722,11 @@ void CppCheck::reportErr(const ErrorMessage &msg)
     if (!mSettings.library.reportErrors(msg.file0))
         return;
 
+    // --diff: only the findings in the changed lines are of interest
+    if (!mSettings.diff.empty() && !msg.callStack.empty() &&
+        !mSettings.diff.isChanged(msg.callStack.back().getfile(false), msg.callStack.back().line, msg.callStack.back().line))
+        return;
+
     std::set<std::string> macroNames;
     if (!msg.callStack.empty()) {
         const std::string &file = msg.callStack.back().getfile(false);
@@ -1668,6 +1824,7 @@ void CppCheck::getErrorMessages(ErrorLogger &errorlogger)
 
     CppCheck cppcheck(errorlogger, true, nullptr);
     cppcheck.purgedConfigurationMessage(emptyString,emptyString);
+    cppcheck.memoryLimitMessage(emptyString);
     cppcheck.mTooManyConfigs = true;
     cppcheck.tooManyConfigsError(emptyString,0U);
     // TODO: add functions to get remaining error messages
@@ -456,6 +456,10 @@ FwdAnalysis::Result FwdAnalysis::check(const Token* expr, const Token* startToke
     if (mWhat == What::Reassign && isGlobalData(expr))
         local = false;
 
+    // A reassignment can only be found if expr occurs again
+    if (mWhat == What::Reassign && mSymbolDatabase && !mSymbolDatabase->hasVarIdBetween(exprVarIds, startToken, endToken))
+        return Result(FwdAnalysis::Result::Type::NONE);
+
     // In unused values checking we do not want to check assignments to
     // global data.
     if (mWhat == What::UnusedValue && isGlobalData(expr))
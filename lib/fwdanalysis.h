@@ -29,6 +29,7 @@
 
 class Token;
 class Settings;
+class SymbolDatabase;
 
 /**
  * Forward data flow analysis for checks
@@ -40,6 +41,9 @@ class FwdAnalysis {
 public:
     explicit FwdAnalysis(const Settings &settings) : mSettings(settings) {}
 
+    /** The symbol database is used to skip the analysis when there are no further uses of the expression */
+    FwdAnalysis(const Settings &settings, const SymbolDatabase &symbolDatabase) : mSettings(settings), mSymbolDatabase(&symbolDatabase) {}
+
     bool hasOperand(const Token *tok, const Token *lhs) const;
 
     /**
@@ -84,6 +88,7 @@ private:
     Result checkRecursive(const Token *expr, const Token *startToken, const Token *endToken, const std::set<nonneg int> &exprVarIds, bool local, bool inInnerClass, int depth=0);
 
     const Settings &mSettings;
+    const SymbolDatabase *mSymbolDatabase{};
     enum class What : std::uint8_t { Reassign, UnusedValue, ValueFlow } mWhat = What::Reassign;
     std::vector<KnownAndToken> mValueFlow;
     bool mValueFlowKnown = true;
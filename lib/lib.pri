@@ -8,6 +8,7 @@ HEADERS += $${PWD}/addoninfo.h \
            $${PWD}/analyzerinfo.h \
            $${PWD}/astutils.h \
            $${PWD}/calculate.h \
+           $${PWD}/changedlines.h \
            $${PWD}/check.h \
            $${PWD}/check64bit.h \
            $${PWD}/checkassert.h \
@@ -53,6 +54,7 @@ HEADERS += $${PWD}/addoninfo.h \
            $${PWD}/keywords.h \
            $${PWD}/library.h \
            $${PWD}/mathlib.h \
+           $${PWD}/memoryusage.h \
            $${PWD}/path.h \
            $${PWD}/pathanalysis.h \
            $${PWD}/pathmatch.h \
@@ -63,6 +65,7 @@ HEADERS += $${PWD}/addoninfo.h \
            $${PWD}/reverseanalyzer.h \
            $${PWD}/settings.h \
            $${PWD}/smallvector.h \
+           $${PWD}/stablevector.h \
            $${PWD}/standards.h \
            $${PWD}/summaries.h \
            $${PWD}/suppressions.h \
@@ -91,6 +94,7 @@ SOURCES += $${PWD}/valueflow.cpp \
            $${PWD}/addoninfo.cpp \
            $${PWD}/analyzerinfo.cpp \
            $${PWD}/astutils.cpp \
+           $${PWD}/changedlines.cpp \
            $${PWD}/check.cpp \
            $${PWD}/check64bit.cpp \
            $${PWD}/checkassert.cpp \
@@ -132,6 +136,7 @@ SOURCES += $${PWD}/valueflow.cpp \
            $${PWD}/keywords.cpp \
            $${PWD}/library.cpp \
            $${PWD}/mathlib.cpp \
+           $${PWD}/memoryusage.cpp \
            $${PWD}/path.cpp \
            $${PWD}/pathanalysis.cpp \
            $${PWD}/pathmatch.cpp \
@@ -954,11 +954,11 @@ bool Library::isIntArgValid(const Token *ftok, int argnr, const MathLib::bigint
     TokenList tokenList(nullptr);
     gettokenlistfromvalid(ac->valid, ftok->isCpp(), tokenList);
     for (const Token *tok = tokenList.front(); tok; tok = tok->next()) {
-        if (tok->isNumber() && argvalue == MathLib::toBigNumber(tok->str()))
+        if (tok->isNumber() && argvalue == tok->getIntNumber())
             return true;
-        if (Token::Match(tok, "%num% : %num%") && argvalue >= MathLib::toBigNumber(tok->str()) && argvalue <= MathLib::toBigNumber(tok->strAt(2)))
+        if (Token::Match(tok, "%num% : %num%") && argvalue >= tok->getIntNumber() && argvalue <= tok->tokAt(2)->getIntNumber())
             return true;
-        if (Token::Match(tok, "%num% : ,") && argvalue >= MathLib::toBigNumber(tok->str()))
+        if (Token::Match(tok, "%num% : ,") && argvalue >= tok->getIntNumber())
             return true;
         if ((!tok->previous() || tok->strAt(-1) == ",") && Token::Match(tok,": %num%") && argvalue <= MathLib::toBigNumber(tok->strAt(1)))
             return true;
@@ -974,9 +974,9 @@ bool Library::isFloatArgValid(const Token *ftok, int argnr, double argvalue) con
     TokenList tokenList(nullptr);
     gettokenlistfromvalid(ac->valid, ftok->isCpp(), tokenList);
     for (const Token *tok = tokenList.front(); tok; tok = tok->next()) {
-        if (Token::Match(tok, "%num% : %num%") && argvalue >= MathLib::toDoubleNumber(tok->str()) && argvalue <= MathLib::toDoubleNumber(tok->strAt(2)))
+        if (Token::Match(tok, "%num% : %num%") && argvalue >= tok->getFloatNumber() && argvalue <= tok->tokAt(2)->getFloatNumber())
             return true;
-        if (Token::Match(tok, "%num% : ,") && argvalue >= MathLib::toDoubleNumber(tok->str()))
+        if (Token::Match(tok, "%num% : ,") && argvalue >= tok->getFloatNumber())
             return true;
         if ((!tok->previous() || tok->strAt(-1) == ",") && Token::Match(tok,": %num%") && argvalue <= MathLib::toDoubleNumber(tok->strAt(1)))
             return true;
@@ -0,0 +1,278 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memoryusage.h"
+
+#include "errortypes.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+#if !defined(WIN32) && !defined(__MINGW32__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+    std::atomic<bool> hooked{false};
+    std::atomic<bool> counting{false};
+
+    // only trivial thread locals are used by allocated() and deallocated()
+    thread_local std::int64_t currentBytes = 0;
+    thread_local std::int64_t peakBytes = 0;
+    thread_local std::int64_t fileStart = 0;
+    thread_local bool recordingFile = false;
+    thread_local std::int64_t fileLimit = 0;
+    thread_local bool fileLimitExceeded = false;
+    thread_local std::vector<std::pair<std::string, std::int64_t>> filePhases;
+
+    std::mutex resultsSync;
+    std::vector<MemoryUsage::FileResults> results;
+
+    using PhasePeak = std::pair<std::string, std::int64_t>;
+
+    bool morePeak(const PhasePeak &lhs, const PhasePeak &rhs)
+    {
+        return lhs.second > rhs.second;
+    }
+
+    /** Peak resident set size in bytes, -1 if unknown */
+    std::int64_t maxResidentSetSize(bool children)
+    {
+#if !defined(WIN32) && !defined(__MINGW32__)
+        rusage usage{};
+        if (getrusage(children ? RUSAGE_CHILDREN : RUSAGE_SELF, &usage) != 0)
+            return -1;
+#if defined(__APPLE__)
+        return usage.ru_maxrss;
+#else
+        return static_cast<std::int64_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+        (void)children;
+        return -1;
+#endif
+    }
+}
+
+void MemoryUsage::setHooked()
+{
+    hooked = true;
+}
+
+bool MemoryUsage::isHooked()
+{
+    return hooked;
+}
+
+void MemoryUsage::setCounting(bool c)
+{
+    counting.store(c, std::memory_order_relaxed);
+}
+
+bool MemoryUsage::isCounting()
+{
+    return counting.load(std::memory_order_relaxed);
+}
+
+void MemoryUsage::allocated(std::size_t size)
+{
+    currentBytes += static_cast<std::int64_t>(size);
+    if (currentBytes > peakBytes)
+        peakBytes = currentBytes;
+}
+
+void MemoryUsage::deallocated(std::size_t size)
+{
+    currentBytes -= static_cast<std::int64_t>(size);
+}
+
+std::int64_t MemoryUsage::current()
+{
+    return currentBytes;
+}
+
+MemoryUsage::Phase MemoryUsage::startPhase()
+{
+    const Phase phase{currentBytes, peakBytes};
+    peakBytes = currentBytes;
+    return phase;
+}
+
+void MemoryUsage::stopPhase(const std::string &name, const Phase &phase)
+{
+    const std::int64_t peak = peakBytes - phase.start;
+    if (recordingFile) {
+        const auto it = std::find_if(filePhases.begin(), filePhases.end(), [&](const PhasePeak &p) {
+            return p.first == name;
+        });
+        if (it == filePhases.end())
+            filePhases.emplace_back(name, peak);
+        else
+            it->second = std::max(it->second, peak);
+    }
+    peakBytes = std::max(phase.outerPeak, peakBytes);
+}
+
+void MemoryUsage::startFile(std::int64_t limit)
+{
+    fileStart = currentBytes;
+    peakBytes = currentBytes;
+    filePhases.clear();
+    recordingFile = true;
+    fileLimit = limit;
+    fileLimitExceeded = false;
+}
+
+MemoryUsage::FileResults MemoryUsage::stopFile(std::string file)
+{
+    FileResults fileResults;
+    fileResults.file = std::move(file);
+    fileResults.peak = peakBytes - fileStart;
+    fileResults.phases.swap(filePhases);
+    recordingFile = false;
+    fileLimit = 0;
+    fileLimitExceeded = false;
+    return fileResults;
+}
+
+bool MemoryUsage::limitExceeded()
+{
+    if (!fileLimitExceeded && fileLimit > 0 && currentBytes - fileStart > fileLimit)
+        fileLimitExceeded = true;
+    return fileLimitExceeded;
+}
+
+std::string MemoryUsage::FileResults::toString(std::size_t top) const
+{
+    std::vector<PhasePeak> sorted(phases);
+    std::stable_sort(sorted.begin(), sorted.end(), morePeak);
+    if (sorted.size() > top)
+        sorted.resize(top);
+
+    std::string ret = "Memory usage: " + file + ": " + toMiB(peak);
+    for (const PhasePeak &phase : sorted)
+        ret += "\n  " + phase.first + ": +" + toMiB(phase.second);
+    return ret;
+}
+
+std::string MemoryUsage::FileResults::serialize() const
+{
+    std::ostringstream oss;
+    oss << peak << ' ' << file << '\n';
+    for (const PhasePeak &phase : phases)
+        oss << phase.second << ' ' << phase.first << '\n';
+    return oss.str();
+}
+
+void MemoryUsage::FileResults::deserialize(const std::string &data)
+{
+    std::istringstream iss(data);
+    std::string line;
+    bool first = true;
+    while (std::getline(iss, line)) {
+        const std::string::size_type pos = line.find(' ');
+        std::int64_t bytes = 0;
+        if (pos == std::string::npos || !(std::istringstream(line.substr(0, pos)) >> bytes))
+            throw InternalError(nullptr, "Internal Error: Deserialization of memory usage failed - invalid line '" + line + "'");
+        if (first) {
+            peak = bytes;
+            file = line.substr(pos + 1);
+            first = false;
+        } else {
+            phases.emplace_back(line.substr(pos + 1), bytes);
+        }
+    }
+    if (first)
+        throw InternalError(nullptr, "Internal Error: Deserialization of memory usage failed - no data");
+}
+
+void MemoryUsage::addResults(FileResults fileResults)
+{
+    std::lock_guard<std::mutex> l(resultsSync);
+    results.push_back(std::move(fileResults));
+}
+
+std::vector<MemoryUsage::FileResults> MemoryUsage::takeResults()
+{
+    std::lock_guard<std::mutex> l(resultsSync);
+    std::vector<FileResults> ret;
+    ret.swap(results);
+    return ret;
+}
+
+std::string MemoryUsage::summary(std::size_t top)
+{
+    std::vector<PhasePeak> files;
+    // the highest peak of each phase, and its file
+    std::vector<PhasePeak> phases;
+    std::vector<std::string> phaseFiles;
+    {
+        std::lock_guard<std::mutex> l(resultsSync);
+        for (const FileResults &fileResults : results) {
+            files.emplace_back(fileResults.file, fileResults.peak);
+            for (const PhasePeak &phase : fileResults.phases) {
+                const auto it = std::find_if(phases.begin(), phases.end(), [&](const PhasePeak &p) {
+                    return p.first == phase.first;
+                });
+                if (it == phases.end()) {
+                    phases.push_back(phase);
+                    phaseFiles.push_back(fileResults.file);
+                } else if (phase.second > it->second) {
+                    it->second = phase.second;
+                    phaseFiles[it - phases.begin()] = fileResults.file;
+                }
+            }
+        }
+    }
+    for (std::size_t i = 0; i < phases.size(); ++i)
+        phases[i].first += " (" + phaseFiles[i] + ")";
+    std::stable_sort(files.begin(), files.end(), morePeak);
+    std::stable_sort(phases.begin(), phases.end(), morePeak);
+
+    std::string ret = "Memory usage of the files with the highest heap usage:";
+    for (std::size_t i = 0; i < files.size() && i < top; ++i)
+        ret += "\n  " + files[i].first + ": " + toMiB(files[i].second);
+    ret += "\nMemory usage of the phases with the highest heap usage:";
+    for (std::size_t i = 0; i < phases.size() && i < top; ++i)
+        ret += "\n  " + phases[i].first + ": +" + toMiB(phases[i].second);
+
+    const std::int64_t rss = maxResidentSetSize(false);
+    if (rss >= 0) {
+        ret += "\nPeak resident set size: " + toMiB(rss);
+        const std::int64_t childRss = maxResidentSetSize(true);
+        if (childRss > 0)
+            ret += " (largest child process: " + toMiB(childRss) + ")";
+    }
+    return ret;
+}
+
+void MemoryUsage::reset()
+{
+    std::lock_guard<std::mutex> l(resultsSync);
+    results.clear();
+}
+
+std::string MemoryUsage::toMiB(std::int64_t bytes)
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1) << (static_cast<double>(bytes) / (1024.0 * 1024.0)) << " MiB";
+    return oss.str();
+}
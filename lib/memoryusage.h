@@ -0,0 +1,107 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+//---------------------------------------------------------------------------
+#ifndef memoryusageH
+#define memoryusageH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Heap usage per thread (--showmemory)
+ *
+ * The allocations are counted by the global operator new and delete of the
+ * executable, which call allocated() and deallocated(). The heap high-water
+ * mark of each Timer phase is recorded for the file that is analyzed in the
+ * current thread.
+ */
+class CPPCHECKLIB MemoryUsage {
+public:
+    /** @brief Set by the executable if its operator new and delete count the allocations */
+    static void setHooked();
+    static bool isHooked();
+
+    static void setCounting(bool counting);
+    static bool isCounting();
+
+    static void allocated(std::size_t size);
+    static void deallocated(std::size_t size);
+
+    /** @brief Heap usage of the current thread in bytes. Only differences are meaningful. */
+    static std::int64_t current();
+
+    /** @brief The state of the enclosing phase, restored when a phase stops */
+    struct Phase {
+        std::int64_t start;
+        std::int64_t outerPeak;
+    };
+
+    static Phase startPhase();
+    static void stopPhase(const std::string &name, const Phase &phase);
+
+    /** @brief The heap high-water marks of the analysis of a file */
+    struct FileResults {
+        std::string file;
+        std::int64_t peak{};
+        /** peak of each phase, by first start */
+        std::vector<std::pair<std::string, std::int64_t>> phases;
+
+        /** the file and its phases with the highest peaks */
+        std::string toString(std::size_t top) const;
+
+        std::string serialize() const;
+        void deserialize(const std::string &data);
+    };
+
+    /** @brief Start recording the phases of a file in the current thread. A limit of 0 means no limit. */
+    static void startFile(std::int64_t limit = 0);
+    static FileResults stopFile(std::string file);
+
+    /**
+     * @brief Has the heap usage of the current file exceeded its limit?
+     * Once exceeded, it stays so until the next file is started.
+     */
+    static bool limitExceeded();
+
+    /** @brief Add the results of a file to the summary */
+    static void addResults(FileResults results);
+
+    /** @brief Remove the results of the files from the summary and return them */
+    static std::vector<FileResults> takeResults();
+
+    /** @brief The files and phases with the highest peaks and the peak resident set size */
+    static std::string summary(std::size_t top);
+
+    static void reset();
+
+    /** @brief Format a size in bytes as MiB */
+    static std::string toMiB(std::int64_t bytes);
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // memoryusageH
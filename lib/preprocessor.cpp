@@ -68,8 +68,7 @@ Preprocessor::Preprocessor(const Settings& settings, ErrorLogger &errorLogger) :
 
 Preprocessor::~Preprocessor()
 {
-    for (const std::pair<const std::string, simplecpp::TokenList*>& tokenList : mTokenLists)
-        delete tokenList.second;
+    clearFiles();
 }
 
 namespace {
@@ -784,6 +783,13 @@ void Preprocessor::removeComments()
     }
 }
 
+void Preprocessor::clearFiles()
+{
+    for (const std::pair<const std::string, simplecpp::TokenList*>& tokenList : mTokenLists)
+        delete tokenList.second;
+    mTokenLists.clear();
+}
+
 void Preprocessor::setPlatformInfo(simplecpp::TokenList *tokens) const
 {
     tokens->sizeOfType["bool"]          = mSettings.platform.sizeof_bool;
@@ -962,26 +968,25 @@ void Preprocessor::dump(std::ostream &out) const
     }
 }
 
-std::size_t Preprocessor::calculateHash(const simplecpp::TokenList &tokens1, const std::string &toolinfo) const
+static void hashTokens(StableHash &hash, const simplecpp::TokenList &tokens)
 {
-    std::string hashData = toolinfo;
-    for (const simplecpp::Token *tok = tokens1.cfront(); tok; tok = tok->next) {
+    for (const simplecpp::Token *tok = tokens.cfront(); tok; tok = tok->next) {
         if (!tok->comment) {
-            hashData += tok->str();
-            hashData += static_cast<char>(tok->location.line);
-            hashData += static_cast<char>(tok->location.col);
+            hash.update(tok->str());
+            hash.update(static_cast<std::uint64_t>(tok->location.line));
+            hash.update(static_cast<std::uint64_t>(tok->location.col));
         }
     }
-    for (std::map<std::string, simplecpp::TokenList *>::const_iterator it = mTokenLists.cbegin(); it != mTokenLists.cend(); ++it) {
-        for (const simplecpp::Token *tok = it->second->cfront(); tok; tok = tok->next) {
-            if (!tok->comment) {
-                hashData += tok->str();
-                hashData += static_cast<char>(tok->location.line);
-                hashData += static_cast<char>(tok->location.col);
-            }
-        }
-    }
-    return (std::hash<std::string>{})(hashData);
+}
+
+std::uint64_t Preprocessor::calculateHash(const simplecpp::TokenList &tokens1, const std::string &toolinfo) const
+{
+    StableHash hash;
+    hash.update(toolinfo);
+    hashTokens(hash, tokens1);
+    for (std::map<std::string, simplecpp::TokenList *>::const_iterator it = mTokenLists.cbegin(); it != mTokenLists.cend(); ++it)
+        hashTokens(hash, *it->second);
+    return hash.digest();
 }
 
 void Preprocessor::simplifyPragmaAsm(simplecpp::TokenList *tokenList) const
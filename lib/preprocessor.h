@@ -133,6 +133,9 @@ public:
 
     void removeComments();
 
+    /** Free the tokens of the included files, they are not needed after the last configuration has been preprocessed */
+    void clearFiles();
+
     void setPlatformInfo(simplecpp::TokenList *tokens) const;
 
     simplecpp::TokenList preprocess(const simplecpp::TokenList &tokens1, const std::string &cfg, std::vector<std::string> &files, bool throwError = false);
@@ -146,7 +149,7 @@ public:
      * @param toolinfo   Arbitrary extra toolinfo
      * @return HASH
      */
-    std::size_t calculateHash(const simplecpp::TokenList &tokens1, const std::string &toolinfo) const;
+    std::uint64_t calculateHash(const simplecpp::TokenList &tokens1, const std::string &toolinfo) const;
 
     void simplifyPragmaAsm(simplecpp::TokenList *tokenList) const;
 
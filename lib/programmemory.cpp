@@ -1401,9 +1401,9 @@ namespace {
                 return *value;
             }
             if (expr->isNumber()) {
-                if (MathLib::isFloat(expr->str()))
+                if (expr->isFloatNumber())
                     return unknown();
-                MathLib::bigint i = MathLib::toBigNumber(expr->str());
+                MathLib::bigint i = expr->getIntNumber();
                 if (i < 0 && astIsUnsigned(expr))
                     return unknown();
                 return ValueFlow::Value{i};
@@ -22,6 +22,7 @@
 //---------------------------------------------------------------------------
 
 #include "addoninfo.h"
+#include "changedlines.h"
 #include "config.h"
 #include "errortypes.h"
 #include "library.h"
@@ -158,6 +159,9 @@ public:
     /** Internal: Clear the simplecpp non-existing include cache */
     bool clearIncludeCache{};
 
+    /** @brief Let the analysis server listening on this socket check the files (--client=&lt;socket&gt;) */
+    std::string clientSocket;
+
     /** @brief include paths excluded from checking the configuration */
     std::set<std::string> configExcludePaths;
 
@@ -188,6 +192,14 @@ public:
     /** @brief Is --debug-warnings given? */
     bool debugwarnings{};
 
+    /**
+     * @brief --diff=&lt;file&gt; : The lines changed by a unified diff. When set,
+     * only the files in the diff are checked, function bodies unrelated to
+     * the changed functions are removed and only findings in the changed
+     * lines are reported.
+     */
+    ChangedLines diff;
+
     /** @brief Is --dump given? */
     bool dump{};
     std::string dumpFile;
@@ -225,6 +237,9 @@ public:
     /** @brief Force checking the files with "too many" configurations (--force). */
     bool force{};
 
+    /** @brief Reuse the findings of the unchanged functions of changed files (--function-cache). */
+    bool functionCache{};
+
     /** @brief List of include paths, e.g. "my/includes/" which should be used
         for finding include files inside source files. (-I) */
     std::list<std::string> includePaths;
@@ -245,6 +260,9 @@ public:
     /** @brief Load average value */
     int loadAverage{};
 
+    /** @brief Run as language server on stdin and stdout (--lsp) */
+    bool lsp{};
+
     /** @brief Maximum number of configurations to check before bailing.
         Default is 12. (--max-configs=N) */
     int maxConfigs = 12;
@@ -252,6 +270,9 @@ public:
     /** @brief --max-ctu-depth */
     int maxCtuDepth = 2;
 
+    /** @brief The maximum heap usage in MiB of the analysis of a single file (--max-memory-per-file=N), 0 = no limit */
+    int maxMemoryPerFile{};
+
     /** @brief max template recursion */
     int maxTemplateRecursion = 100;
 
@@ -278,6 +299,13 @@ public:
     /** @brief Is --quiet given? */
     bool quiet{};
 
+    /**
+     * @brief --reduce-suppressed-headers : Reduce headers whose messages are
+     * all suppressed (--suppress=*:<path>) to declarations. Function bodies
+     * in them are removed unless the function is used outside such headers.
+     */
+    bool reduceSuppressedHeaders{};
+
     /** @brief Use relative paths in output. */
     bool relativePaths{};
 
@@ -356,6 +384,12 @@ public:
     SimpleEnableGroup<Certainty> certainty;
     SimpleEnableGroup<Checks> checks;
 
+    /** @brief Keep the settings resident and check files on request of clients (--server=&lt;socket&gt;) */
+    std::string serverSocket;
+
+    /** @brief show the heap high-water marks of the files and phases (--showmemory) */
+    bool showmemory{};
+
     /** @brief show timing information (--showtime=file|summary|top5) */
     SHOWTIME_MODES showtime{};
 
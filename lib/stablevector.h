@@ -0,0 +1,298 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef stablevectorH
+#define stablevectorH
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Append-only sequence whose elements are never moved.
+ *
+ * The elements are stored in chunks that double in size, so iteration is
+ * mostly contiguous while pointers and references to elements stay valid
+ * like in a std::list. Iterators are positions, so they also stay valid
+ * when elements are appended. As with a std::list, end() always refers to
+ * the current end, so an ongoing iteration (also a range-based for loop)
+ * visits elements that are appended meanwhile. Only the last element can
+ * be removed.
+ */
+template<class T>
+class StableVector {
+    static constexpr std::size_t FirstChunkSize = 4;
+
+    template<class V>
+    class Iterator {
+        friend class StableVector;
+        using Container = typename std::conditional<std::is_const<V>::value, const StableVector, StableVector>::type;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename std::remove_const<V>::type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V*;
+        using reference = V&;
+
+        Iterator() = default;
+        // NOLINTNEXTLINE(google-explicit-constructor) - conversion from iterator to const_iterator
+        template<class W, class = typename std::enable_if<std::is_const<V>::value && std::is_same<W, value_type>::value>::type>
+        Iterator(const Iterator<W> &other) // cppcheck-suppress noExplicitConstructor
+            : mContainer(other.mContainer), mIndex(other.mIndex), mChunk(other.mChunk), mOffset(other.mOffset) {}
+
+        reference operator*() const {
+            return mContainer->mChunks[mChunk][mOffset];
+        }
+        pointer operator->() const {
+            return &**this;
+        }
+        reference operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        Iterator &operator++() {
+            ++mIndex;
+            if (++mOffset == chunkSize(mChunk)) {
+                ++mChunk;
+                mOffset = 0;
+            }
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator it(*this);
+            ++*this;
+            return it;
+        }
+        Iterator &operator--() {
+            if (mIndex == EndIndex)
+                setIndex(mContainer->mSize);
+            --mIndex;
+            if (mOffset == 0) {
+                --mChunk;
+                mOffset = chunkSize(mChunk);
+            }
+            --mOffset;
+            return *this;
+        }
+        Iterator operator--(int) {
+            Iterator it(*this);
+            --*this;
+            return it;
+        }
+        Iterator &operator+=(difference_type n) {
+            setIndex(position() + n);
+            return *this;
+        }
+        Iterator &operator-=(difference_type n) {
+            setIndex(position() - n);
+            return *this;
+        }
+        friend Iterator operator+(Iterator it, difference_type n) {
+            return it += n;
+        }
+        friend Iterator operator+(difference_type n, Iterator it) {
+            return it += n;
+        }
+        friend Iterator operator-(Iterator it, difference_type n) {
+            return it -= n;
+        }
+        friend difference_type operator-(const Iterator &a, const Iterator &b) {
+            return static_cast<difference_type>(a.position()) - static_cast<difference_type>(b.position());
+        }
+
+        friend bool operator==(const Iterator &a, const Iterator &b) {
+            return a.position() == b.position();
+        }
+        friend bool operator!=(const Iterator &a, const Iterator &b) {
+            return a.position() != b.position();
+        }
+        friend bool operator<(const Iterator &a, const Iterator &b) {
+            return a.position() < b.position();
+        }
+        friend bool operator>(const Iterator &a, const Iterator &b) {
+            return a.position() > b.position();
+        }
+        friend bool operator<=(const Iterator &a, const Iterator &b) {
+            return a.position() <= b.position();
+        }
+        friend bool operator>=(const Iterator &a, const Iterator &b) {
+            return a.position() >= b.position();
+        }
+
+    private:
+        /** index of the end() iterator, which follows the size of the container */
+        static constexpr std::size_t EndIndex = ~std::size_t{0};
+
+        Iterator(Container *container, std::size_t index) : mContainer(container) {
+            if (index == EndIndex)
+                mIndex = EndIndex;
+            else
+                setIndex(index);
+        }
+
+        std::size_t position() const {
+            return mIndex == EndIndex ? mContainer->mSize : mIndex;
+        }
+
+        void setIndex(std::size_t index) {
+            mIndex = index;
+            locate(index, mChunk, mOffset);
+        }
+
+        Container *mContainer{};
+        std::size_t mIndex{};
+        std::size_t mChunk{};
+        std::size_t mOffset{};
+
+        template<class>
+        friend class Iterator;
+    };
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
+    StableVector() = default;
+    StableVector(const StableVector &) = delete;
+    StableVector &operator=(const StableVector &) = delete;
+    StableVector(StableVector &&other) noexcept
+        : mChunks(std::move(other.mChunks)), mSize(other.mSize) {
+        other.mChunks.clear();
+        other.mSize = 0;
+    }
+    StableVector &operator=(StableVector &&other) noexcept {
+        if (this != &other) {
+            clear();
+            mChunks = std::move(other.mChunks);
+            mSize = other.mSize;
+            other.mChunks.clear();
+            other.mSize = 0;
+        }
+        return *this;
+    }
+    ~StableVector() {
+        clear();
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+    iterator end() {
+        return iterator(this, iterator::EndIndex);
+    }
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const {
+        return const_iterator(this, const_iterator::EndIndex);
+    }
+    const_iterator cbegin() const {
+        return begin();
+    }
+    const_iterator cend() const {
+        return end();
+    }
+
+    size_type size() const {
+        return mSize;
+    }
+    bool empty() const {
+        return mSize == 0;
+    }
+
+    reference operator[](size_type index) {
+        std::size_t chunk, offset;
+        locate(index, chunk, offset);
+        return mChunks[chunk][offset];
+    }
+    const_reference operator[](size_type index) const {
+        std::size_t chunk, offset;
+        locate(index, chunk, offset);
+        return mChunks[chunk][offset];
+    }
+    reference front() {
+        return mChunks[0][0];
+    }
+    const_reference front() const {
+        return mChunks[0][0];
+    }
+    reference back() {
+        return (*this)[mSize - 1];
+    }
+    const_reference back() const {
+        return (*this)[mSize - 1];
+    }
+
+    template<class... Args>
+    reference emplace_back(Args&&... args) {
+        std::size_t chunk, offset;
+        locate(mSize, chunk, offset);
+        if (chunk == mChunks.size())
+            mChunks.push_back(static_cast<T*>(::operator new(chunkSize(chunk) * sizeof(T))));
+        T *p = new (mChunks[chunk] + offset) T(std::forward<Args>(args)...);
+        ++mSize;
+        return *p;
+    }
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+    void pop_back() {
+        back().~T();
+        --mSize;
+    }
+
+    /** Destroys all elements and releases the memory */
+    void clear() {
+        for (iterator it = begin(); it != end(); ++it)
+            it->~T();
+        for (T *chunk : mChunks)
+            ::operator delete(chunk);
+        mChunks.clear();
+        mSize = 0;
+    }
+
+private:
+    static std::size_t chunkSize(std::size_t chunk) {
+        return FirstChunkSize << chunk;
+    }
+
+    /** Chunk and offset of element with given index. Chunk n starts at index FirstChunkSize * (2^n - 1). */
+    static void locate(std::size_t index, std::size_t &chunk, std::size_t &offset) {
+        const std::size_t q = index / FirstChunkSize + 1;
+        chunk = 0;
+        while ((q >> (chunk + 1)) != 0)
+            ++chunk;
+        offset = index - FirstChunkSize * ((std::size_t{1} << chunk) - 1);
+    }
+
+    std::vector<T*> mChunks;
+    std::size_t mSize{};
+};
+
+#endif
@@ -517,6 +517,19 @@ std::list<SuppressionList::Suppression> SuppressionList::getUnmatchedGlobalSuppr
     return result;
 }
 
+bool SuppressionList::isSuppressedFile(const std::string &file) const
+{
+    return std::any_of(mSuppressions.cbegin(), mSuppressions.cend(), [&](const Suppression &s) {
+        return s.errorId == "*" &&
+               (s.type == SuppressionList::Type::unique || s.type == SuppressionList::Type::file) &&
+               s.lineNumber == Suppression::NO_LINE &&
+               s.symbolName.empty() &&
+               s.hash == 0 &&
+               !s.fileName.empty() &&
+               matchglob(s.fileName, file);
+    });
+}
+
 const std::list<SuppressionList::Suppression> &SuppressionList::getSuppressions() const
 {
     return mSuppressions;
@@ -219,6 +219,14 @@ public:
      */
     bool isSuppressed(const ::ErrorMessage &errmsg, const std::set<std::string>& macroNames);
 
+    /**
+     * @brief Returns true if all messages in the given file are suppressed,
+     * i.e. there is a suppression "*:<pattern>" that matches the file.
+     * @param file file name
+     * @return true if the whole file is suppressed.
+     */
+    bool isSuppressedFile(const std::string &file) const;
+
     /**
      * @brief Create an xml dump of suppressions
      * @param out stream to write XML to
@@ -845,7 +845,7 @@ void SymbolDatabase::createSymbolDatabaseVariableInfo()
 
     // fill in function arguments
     for (Scope& scope : scopeList) {
-        std::list<Function>::iterator func;
+        StableVector<Function>::iterator func;
 
         for (func = scope.functionList.begin(); func != scope.functionList.end(); ++func) {
             // add arguments
@@ -861,7 +861,7 @@ void SymbolDatabase::createSymbolDatabaseCopyAndMoveConstructors()
         if (!scope.isClassOrStruct())
             continue;
 
-        std::list<Function>::iterator func;
+        StableVector<Function>::iterator func;
         for (func = scope.functionList.begin(); func != scope.functionList.end(); ++func) {
             if (!func->isConstructor() || func->minArgCount() != 1)
                 continue;
@@ -903,7 +903,7 @@ void SymbolDatabase::createSymbolDatabaseFunctionReturnTypes()
 {
     // fill in function return types
     for (Scope& scope : scopeList) {
-        std::list<Function>::iterator func;
+        StableVector<Function>::iterator func;
 
         for (func = scope.functionList.begin(); func != scope.functionList.end(); ++func) {
             // add return types
@@ -3288,7 +3288,7 @@ void SymbolDatabase::addClassFunction(Scope *&scope, const Token *&tok, const To
     }
 
     // search for match
-    for (std::list<Scope>::iterator it1 = scopeList.begin(); it1 != scopeList.end(); ++it1) {
+    for (StableVector<Scope>::iterator it1 = scopeList.begin(); it1 != scopeList.end(); ++it1) {
         Scope *scope1 = &(*it1);
 
         bool match = false;
@@ -3583,6 +3583,38 @@ std::string Type::name() const
     return result;
 }
 
+bool SymbolDatabase::hasVarIdBetween(const std::set<nonneg int> &varIds, const Token *start, const Token *end) const
+{
+    if (!mVarIdOccurrencesIndexed) {
+        mVarIdOccurrencesIndexed = true;
+        mVarIdOccurrencesValid = true;
+        nonneg int prevIndex = 0;
+        for (const Token *tok = mTokenizer.tokens(); tok; tok = tok->next()) {
+            // the index can only be used if the token indexes are ascending
+            if (tok->index() <= prevIndex) {
+                mVarIdOccurrencesValid = false;
+                mVarIdOccurrences.clear();
+                break;
+            }
+            prevIndex = tok->index();
+            if (tok->varId() > 0)
+                mVarIdOccurrences[tok->varId()].push_back(tok->index());
+        }
+    }
+    if (!mVarIdOccurrencesValid)
+        return true;
+
+    for (const nonneg int varId : varIds) {
+        const auto it = mVarIdOccurrences.find(varId);
+        if (it == mVarIdOccurrences.end())
+            continue;
+        const auto occurrence = std::lower_bound(it->second.cbegin(), it->second.cend(), start->index());
+        if (occurrence != it->second.cend() && (!end || *occurrence < end->index()))
+            return true;
+    }
+    return false;
+}
+
 void SymbolDatabase::debugMessage(const Token *tok, const std::string &type, const std::string &msg) const
 {
     if (tok && mSettings.debugwarnings) {
@@ -3683,7 +3715,7 @@ bool Variable::arrayDimensions(const Settings& settings, bool& isContainer)
             if (Token::Match(tok, "%num% [,>]")) {
                 dimension_.tok = tok;
                 dimension_.known = true;
-                dimension_.num = MathLib::toBigNumber(tok->str());
+                dimension_.num = tok->getIntNumber();
             } else if (tok) {
                 dimension_.tok = tok;
                 dimension_.known = false;
@@ -3938,7 +3970,7 @@ void SymbolDatabase::printOut(const char *title) const
     if (title)
         std::cout << "\n### " << title << " ###\n";
 
-    for (std::list<Scope>::const_iterator scope = scopeList.cbegin(); scope != scopeList.cend(); ++scope) {
+    for (StableVector<Scope>::const_iterator scope = scopeList.cbegin(); scope != scopeList.cend(); ++scope) {
         std::cout << "Scope: " << &*scope << " " << scope->type << std::endl;
         std::cout << "    className: " << scope->className << std::endl;
         std::cout << "    classDef: " << tokenToString(scope->classDef, mTokenizer) << std::endl;
@@ -4093,7 +4125,7 @@ void SymbolDatabase::printOut(const char *title) const
         std::cout << std::endl;
     }
 
-    for (std::list<Type>::const_iterator type = typeList.cbegin(); type != typeList.cend(); ++type) {
+    for (StableVector<Type>::const_iterator type = typeList.cbegin(); type != typeList.cend(); ++type) {
         std::cout << "Type: " << &(*type) << std::endl;
         std::cout << "    name: " << type->name() << std::endl;
         std::cout << "    classDef: " << tokenToString(type->classDef, mTokenizer) << std::endl;
@@ -4168,7 +4200,7 @@ void SymbolDatabase::printXml(std::ostream &out) const
 
     // Scopes..
     outs += "  <scopes>\n";
-    for (std::list<Scope>::const_iterator scope = scopeList.cbegin(); scope != scopeList.cend(); ++scope) {
+    for (StableVector<Scope>::const_iterator scope = scopeList.cbegin(); scope != scopeList.cend(); ++scope) {
         outs += "    <scope";
         outs += " id=\"";
         outs += id_string(&*scope);
@@ -4212,7 +4244,7 @@ void SymbolDatabase::printXml(std::ostream &out) const
             outs += ">\n";
             if (!scope->functionList.empty()) {
                 outs += "      <functionList>\n";
-                for (std::list<Function>::const_iterator function = scope->functionList.cbegin(); function != scope->functionList.cend(); ++function) {
+                for (StableVector<Function>::const_iterator function = scope->functionList.cbegin(); function != scope->functionList.cend(); ++function) {
                     outs += "        <function id=\"";
                     outs += id_string(&*function);
                     outs += "\" token=\"";
@@ -4766,6 +4798,7 @@ void Scope::addVariable(const Token *token_, const Token *start_, const Token *e
     // C4267 VC++ warning instead of several dozens lines
     const int varIndex = varlist.size();
     varlist.emplace_back(token_, start_, end_, varIndex, access_, type_, scope_, settings);
+    varMap.insert(make_pair(varlist.back().name(), &varlist.back()));
 }
 
 // Get variable list..
@@ -4972,11 +5005,9 @@ const Token *Scope::checkVariable(const Token *tok, AccessControl varaccess, con
 
 const Variable *Scope::getVariable(const std::string &varname) const
 {
-    auto it = std::find_if(varlist.begin(), varlist.end(), [&varname](const Variable& var) {
-        return var.name() == varname;
-    });
-    if (it != varlist.end())
-        return &*it;
+    auto it = varMap.lower_bound(varname);
+    if (it != varMap.end() && it->first == varname)
+        return it->second;
 
     if (definedType) {
         for (const Type::BaseInfo& baseInfo: definedType->derivedFrom) {
@@ -7343,7 +7374,7 @@ void SymbolDatabase::setValueTypeInTokenList(bool reportDebugWarnings, Token *to
 
     for (Token *tok = tokens; tok; tok = tok->next()) {
         if (tok->isNumber()) {
-            if (MathLib::isFloat(tok->str())) {
+            if (tok->isFloatNumber()) {
                 ValueType::Type type = ValueType::Type::DOUBLE;
                 const char suffix = tok->str()[tok->str().size() - 1];
                 if (suffix == 'f' || suffix == 'F')
@@ -7351,7 +7382,7 @@ void SymbolDatabase::setValueTypeInTokenList(bool reportDebugWarnings, Token *to
                 else if (suffix == 'L' || suffix == 'l')
                     type = ValueType::Type::LONGDOUBLE;
                 setValueType(tok, ValueType(ValueType::Sign::UNKNOWN_SIGN, type, 0U));
-            } else if (MathLib::isInt(tok->str())) {
+            } else if (tok->isIntNumber()) {
                 const std::string tokStr = MathLib::abs(tok->str());
                 const bool unsignedSuffix = (tokStr.find_last_of("uU") != std::string::npos);
                 ValueType::Sign sign = unsignedSuffix ? ValueType::Sign::UNSIGNED : ValueType::Sign::SIGNED;
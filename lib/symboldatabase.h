@@ -26,6 +26,7 @@
 #include "library.h"
 #include "mathlib.h"
 #include "sourcelocation.h"
+#include "stablevector.h"
 #include "token.h"
 #include "utils.h"
 
@@ -37,6 +38,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -1032,9 +1034,10 @@ public:
     const Token* classDef{};   ///< class/struct/union/namespace token
     const Token* bodyStart{};  ///< '{' token
     const Token* bodyEnd{};    ///< '}' token
-    std::list<Function> functionList;
+    StableVector<Function> functionList;
     std::multimap<std::string, const Function *> functionMap;
     std::list<Variable> varlist;
+    std::multimap<std::string, const Variable *> varMap;
     const Scope* nestedIn{};
     std::vector<Scope *> nestedList;
     nonneg int numConstructors{};
@@ -1324,7 +1327,7 @@ public:
     ~SymbolDatabase();
 
     /** @brief Information about all namespaces/classes/structures */
-    std::list<Scope> scopeList;
+    StableVector<Scope> scopeList;
 
     /** @brief Fast access to function scopes */
     std::vector<const Scope*> functionScopes;
@@ -1333,7 +1336,7 @@ public:
     std::vector<const Scope*> classAndStructScopes;
 
     /** @brief Fast access to types */
-    std::list<Type> typeList;
+    StableVector<Type> typeList;
 
     /**
      * @brief find a variable type if it's a user defined type
@@ -1377,6 +1380,16 @@ public:
         return mVariableList;
     }
 
+    /**
+     * @brief Is any of the given variables used in the range [start, end)?
+     * The occurrences of all variables are indexed on the first call.
+     * @param varIds variable ids to look for
+     * @param start first token of the range
+     * @param end token after the range, nullptr for the end of the token list
+     * @return false if none of the variables occur in the range
+     */
+    bool hasVarIdBetween(const std::set<nonneg int> &varIds, const Token *start, const Token *end) const;
+
     /**
      * @brief output a debug message
      */
@@ -1474,7 +1487,12 @@ private:
     std::vector<const Variable *> mVariableList;
 
     /** list for missing types */
-    std::list<Type> mBlankTypes;
+    StableVector<Type> mBlankTypes;
+
+    /** token indexes where each variable occurs, see hasVarIdBetween() */
+    mutable std::unordered_map<nonneg int, std::vector<nonneg int>> mVarIdOccurrences;
+    mutable bool mVarIdOccurrencesIndexed{};
+    mutable bool mVarIdOccurrencesValid{};
 
     ValueType::Sign mDefaultSignedness;
 };
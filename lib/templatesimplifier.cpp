@@ -2505,13 +2505,13 @@ void TemplateSimplifier::simplifyTemplateArgs(Token *start, const Token *end, st
                     tok = tok->linkAt(1);
                 }
             } else if (Token::Match(tok, "%num% %comp% %num%") &&
-                       MathLib::isInt(tok->str()) &&
-                       MathLib::isInt(tok->strAt(2))) {
+                       tok->isIntNumber() &&
+                       tok->tokAt(2)->isIntNumber()) {
                 if ((Token::Match(tok->previous(), "(|&&|%oror%|,") || tok == start) &&
                     (Token::Match(tok->tokAt(3), ")|&&|%oror%|?") || tok->tokAt(3) == end)) {
-                    const MathLib::bigint op1(MathLib::toBigNumber(tok->str()));
+                    const MathLib::bigint op1(tok->getIntNumber());
                     const std::string &cmp(tok->strAt(1));
-                    const MathLib::bigint op2(MathLib::toBigNumber(tok->strAt(2)));
+                    const MathLib::bigint op2(tok->tokAt(2)->getIntNumber());
 
                     std::string result;
 
@@ -2682,7 +2682,7 @@ bool TemplateSimplifier::simplifyCalculations(Token* frontToken, const Token *ba
 
         if (validTokenEnd(bounded, tok, backToken, 3) &&
             Token::Match(tok->previous(), "(|&&|%oror% %char% %comp% %num% &&|%oror%|)")) {
-            tok->str(std::to_string(MathLib::toBigNumber(tok->str())));
+            tok->str(std::to_string(tok->getIntNumber()));
         }
 
         if (validTokenEnd(bounded, tok, backToken, 5) &&
@@ -2873,14 +2873,14 @@ bool TemplateSimplifier::simplifyCalculations(Token* frontToken, const Token *ba
 
             if (validTokenEnd(bounded, tok, backToken, 2) &&
                 Token::Match(tok, "%num% %comp% %num%") &&
-                MathLib::isInt(tok->str()) &&
-                MathLib::isInt(tok->strAt(2))) {
+                tok->isIntNumber() &&
+                tok->tokAt(2)->isIntNumber()) {
                 if (validTokenStart(bounded, tok, frontToken, -1) &&
                     Token::Match(tok->previous(), "(|&&|%oror%") &&
                     Token::Match(tok->tokAt(3), ")|&&|%oror%|?")) {
-                    const MathLib::bigint op1(MathLib::toBigNumber(tok->str()));
+                    const MathLib::bigint op1(tok->getIntNumber());
                     const std::string &cmp(tok->strAt(1));
-                    const MathLib::bigint op2(MathLib::toBigNumber(tok->strAt(2)));
+                    const MathLib::bigint op2(tok->tokAt(2)->getIntNumber());
 
                     std::string result;
 
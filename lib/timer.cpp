@@ -21,10 +21,18 @@
 #include "utils.h"
 
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <iostream>
 #include <utility>
 #include <vector>
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace {
     using dataElementType = std::pair<std::string, TimerResultsData>;
     bool more_second_sec(const dataElementType& lhs, const dataElementType& rhs)
@@ -34,6 +42,126 @@ namespace {
 
     // TODO: remove and print through (synchronized) ErrorLogger instead
     std::mutex stdCoutLock;
+
+    std::mutex countersSync;
+    std::string countersUnavailable;
+
+    void setCountersUnavailable(const std::string& reason)
+    {
+        std::lock_guard<std::mutex> l(countersSync);
+        if (countersUnavailable.empty())
+            countersUnavailable = reason;
+    }
+
+    const char * const counterNames[] = {"instructions", "cycles", "cache misses", "branch misses"};
+
+    void printCounters(const TimerCounters& counters)
+    {
+        const std::uint64_t values[] = {counters.instructions, counters.cycles, counters.cacheMisses, counters.branchMisses};
+        for (std::size_t i = 0; i < 4; ++i)
+            std::cout << (i == 0 ? " - " : ", ") << counterNames[i] << ": " << values[i];
+    }
+
+#if defined(__linux__)
+    /** The perf_event_open() counters of a thread, read as one group */
+    class CounterGroup {
+    public:
+        CounterGroup() {
+            // the first counter is the group leader, the others are optional
+            open(PERF_COUNT_HW_INSTRUCTIONS, &TimerCounters::instructions, counterNames[0]);
+            if (mFds.empty())
+                return;
+            open(PERF_COUNT_HW_CPU_CYCLES, &TimerCounters::cycles, counterNames[1]);
+            open(PERF_COUNT_HW_CACHE_MISSES, &TimerCounters::cacheMisses, counterNames[2]);
+            open(PERF_COUNT_HW_BRANCH_MISSES, &TimerCounters::branchMisses, counterNames[3]);
+        }
+
+        ~CounterGroup() {
+            for (const int fd : mFds)
+                close(fd);
+        }
+
+        CounterGroup(const CounterGroup&) = delete;
+        CounterGroup& operator=(const CounterGroup&) = delete;
+
+        bool read(TimerCounters& counters) const {
+            if (mFds.empty())
+                return false;
+            // PERF_FORMAT_GROUP: the number of counters, then their values
+            std::uint64_t data[5] = {};
+            const ssize_t size = ::read(mFds.front(), data, sizeof(data));
+            if (size < static_cast<ssize_t>(sizeof(std::uint64_t)) || data[0] != mMembers.size())
+                return false;
+            counters = TimerCounters();
+            for (std::size_t i = 0; i < mMembers.size(); ++i)
+                counters.*mMembers[i] = data[i + 1];
+            return true;
+        }
+
+    private:
+        void open(std::uint64_t config, std::uint64_t TimerCounters::* member, const char* name) {
+            perf_event_attr attr{};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = config;
+            attr.read_format = PERF_FORMAT_GROUP;
+            // the default perf_event_paranoid level only allows user space counters
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            const int groupFd = mFds.empty() ? -1 : mFds.front();
+            const int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0));
+            if (fd < 0) {
+                std::string reason = std::string("perf_event_open() failed for ") + name + ": " + std::strerror(errno);
+                if (errno == EACCES || errno == EPERM)
+                    reason += " (see /proc/sys/kernel/perf_event_paranoid)";
+                setCountersUnavailable(reason);
+                return;
+            }
+            mFds.push_back(fd);
+            mMembers.push_back(member);
+        }
+
+        std::vector<int> mFds;
+        std::vector<std::uint64_t TimerCounters::*> mMembers;
+    };
+#endif
+}
+
+TimerCounters& TimerCounters::operator+=(const TimerCounters& other)
+{
+    instructions += other.instructions;
+    cycles += other.cycles;
+    cacheMisses += other.cacheMisses;
+    branchMisses += other.branchMisses;
+    return *this;
+}
+
+TimerCounters& TimerCounters::operator-=(const TimerCounters& other)
+{
+    instructions -= other.instructions;
+    cycles -= other.cycles;
+    cacheMisses -= other.cacheMisses;
+    branchMisses -= other.branchMisses;
+    return *this;
+}
+
+bool TimerCounters::read(TimerCounters& counters)
+{
+#if defined(__linux__)
+    // the counters only count the thread that opened them
+    static thread_local const CounterGroup group;
+    return group.read(counters);
+#else
+    (void)counters;
+    setCountersUnavailable("hardware performance counters are only supported on Linux");
+    return false;
+#endif
+}
+
+std::string TimerCounters::unavailableReason()
+{
+    std::lock_guard<std::mutex> l(countersSync);
+    return countersUnavailable;
 }
 
 // TODO: this does not include any file context when SHOWTIME_FILE thus rendering it useless - should we include the logging with the progress logging?
@@ -76,16 +204,31 @@ void TimerResults::showResults(SHOWTIME_MODES mode) const
                     return d.first.size() == pos && iter->first.compare(0, d.first.size(), d.first) == 0;
                 });
         }
-        if (!hasParent)
+        if (!hasParent) {
             overallData.mClocks += iter->second.mClocks;
+            overallData.mCounters += iter->second.mCounters;
+            overallData.mHasCounters |= iter->second.mHasCounters;
+        }
         if ((mode != SHOWTIME_MODES::SHOWTIME_TOP5_FILE && mode != SHOWTIME_MODES::SHOWTIME_TOP5_SUMMARY) || (ordinal<=5)) {
-            std::cout << iter->first << ": " << sec << "s (avg. " << secAverage << "s - " << iter->second.mNumberOfResults  << " result(s))" << std::endl;
+            std::cout << iter->first << ": " << sec << "s (avg. " << secAverage << "s - " << iter->second.mNumberOfResults  << " result(s))";
+            if (iter->second.mHasCounters)
+                printCounters(iter->second.mCounters);
+            std::cout << std::endl;
         }
         ++ordinal;
     }
 
     const double secOverall = overallData.seconds();
-    std::cout << "Overall time: " << secOverall << "s" << std::endl;
+    std::cout << "Overall time: " << secOverall << "s";
+    if (overallData.mHasCounters)
+        printCounters(overallData.mCounters);
+    std::cout << std::endl;
+
+    if (mode == SHOWTIME_MODES::SHOWTIME_COUNTERS) {
+        const std::string reason = TimerCounters::unavailableReason();
+        if (!reason.empty())
+            std::cout << "Hardware performance counters: " << reason << std::endl;
+    }
 }
 
 void TimerResults::addResults(const std::string& str, std::clock_t clocks)
@@ -96,6 +239,15 @@ void TimerResults::addResults(const std::string& str, std::clock_t clocks)
     mResults[str].mNumberOfResults++;
 }
 
+void TimerResults::addCounters(const std::string& str, const TimerCounters& counters)
+{
+    std::lock_guard<std::mutex> l(mResultsSync);
+
+    TimerResultsData& data = mResults[str];
+    data.mCounters += counters;
+    data.mHasCounters = true;
+}
+
 void TimerResults::reset()
 {
     std::lock_guard<std::mutex> l(mResultsSync);
@@ -108,7 +260,14 @@ Timer::Timer(std::string str, SHOWTIME_MODES showtimeMode, TimerResultsIntf* tim
     , mStart(std::clock())
     , mShowTimeMode(showtimeMode)
     , mStopped(showtimeMode == SHOWTIME_MODES::SHOWTIME_NONE || showtimeMode == SHOWTIME_MODES::SHOWTIME_FILE_TOTAL)
-{}
+    , mMemory(MemoryUsage::isCounting())
+{
+    if (mMemory)
+        mMemoryPhase = MemoryUsage::startPhase();
+    // read last so the counters do not include the setup of the timer
+    if (showtimeMode == SHOWTIME_MODES::SHOWTIME_COUNTERS && mTimerResults)
+        mCounters = TimerCounters::read(mStartCounters);
+}
 
 Timer::Timer(bool fileTotal, std::string filename)
     : mStr(std::move(filename))
@@ -123,6 +282,11 @@ Timer::~Timer()
 void Timer::stop()
 {
     if ((mShowTimeMode != SHOWTIME_MODES::SHOWTIME_NONE) && !mStopped) {
+        TimerCounters counters;
+        if (mCounters && TimerCounters::read(counters))
+            counters -= mStartCounters;
+        else
+            mCounters = false;
         const std::clock_t end = std::clock();
         const std::clock_t diff = end - mStart;
 
@@ -137,8 +301,15 @@ void Timer::stop()
         } else {
             if (mTimerResults)
                 mTimerResults->addResults(mStr, diff);
+            if (mCounters)
+                mTimerResults->addCounters(mStr, counters);
         }
     }
 
+    if (mMemory) {
+        MemoryUsage::stopPhase(mStr, mMemoryPhase);
+        mMemory = false;
+    }
+
     mStopped = true;
 }
@@ -21,6 +21,7 @@
 //---------------------------------------------------------------------------
 
 #include "config.h"
+#include "memoryusage.h"
 
 #include <cstdint>
 #include <ctime>
@@ -34,7 +35,30 @@ enum class SHOWTIME_MODES : std::uint8_t {
     SHOWTIME_FILE_TOTAL,
     SHOWTIME_SUMMARY,
     SHOWTIME_TOP5_SUMMARY,
-    SHOWTIME_TOP5_FILE
+    SHOWTIME_TOP5_FILE,
+    SHOWTIME_COUNTERS
+};
+
+/**
+ * @brief Hardware performance counters of the current thread (--showtime=counters)
+ *
+ * The counters are opened with perf_event_open() on Linux. They are not
+ * available on other platforms or when the kernel forbids the access.
+ */
+struct CPPCHECKLIB TimerCounters {
+    std::uint64_t instructions{};
+    std::uint64_t cycles{};
+    std::uint64_t cacheMisses{};
+    std::uint64_t branchMisses{};
+
+    TimerCounters& operator+=(const TimerCounters& other);
+    TimerCounters& operator-=(const TimerCounters& other);
+
+    /** @brief Read the counters of the current thread. Returns false if they are not available. */
+    static bool read(TimerCounters& counters);
+
+    /** @brief Why the counters are not available, empty if they are or were not read */
+    static std::string unavailableReason();
 };
 
 class CPPCHECKLIB TimerResultsIntf {
@@ -42,11 +66,15 @@ public:
     virtual ~TimerResultsIntf() = default;
 
     virtual void addResults(const std::string& str, std::clock_t clocks) = 0;
+
+    virtual void addCounters(const std::string& /*str*/, const TimerCounters& /*counters*/) {}
 };
 
 struct TimerResultsData {
     std::clock_t mClocks{};
     long mNumberOfResults{};
+    TimerCounters mCounters;
+    bool mHasCounters{};
 
     double seconds() const {
         const double ret = (double)((unsigned long)mClocks) / (double)CLOCKS_PER_SEC;
@@ -60,6 +88,7 @@ public:
 
     void showResults(SHOWTIME_MODES mode) const;
     void addResults(const std::string& str, std::clock_t clocks) override;
+    void addCounters(const std::string& str, const TimerCounters& counters) override;
 
     void reset();
 
@@ -85,6 +114,14 @@ private:
     std::clock_t mStart = std::clock();
     const SHOWTIME_MODES mShowTimeMode = SHOWTIME_MODES::SHOWTIME_FILE_TOTAL;
     bool mStopped{};
+
+    /** the heap high-water mark of the phase is recorded (--showmemory) */
+    bool mMemory{};
+    MemoryUsage::Phase mMemoryPhase{};
+
+    /** the hardware performance counters at the start (--showtime=counters) */
+    bool mCounters{};
+    TimerCounters mStartCounters;
 };
 //---------------------------------------------------------------------------
 #endif // timerH
@@ -20,6 +20,7 @@
 
 #include "astutils.h"
 #include "errortypes.h"
+#include "keywords.h"
 #include "library.h"
 #include "settings.h"
 #include "simplecpp.h"
@@ -43,6 +44,7 @@
 #include <sstream>
 #include <stack>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -72,6 +74,8 @@ Token::Token(const Token* tok)
 
 Token::~Token()
 {
+    if (mImpl && mImpl->mCountedName)
+        uncountName();
     delete mImpl;
 }
 
@@ -100,12 +104,160 @@ static const std::unordered_set<std::string> controlFlowKeywords = {
     "return"
 };
 
+static const std::unordered_set<std::string> stdTypes = { "bool"
+                                                          , "_Bool"
+                                                          , "char"
+                                                          , "double"
+                                                          , "float"
+                                                          , "int"
+                                                          , "long"
+                                                          , "short"
+                                                          , "size_t"
+                                                          , "void"
+                                                          , "wchar_t"
+};
+
+namespace {
+    enum NameProperty : std::uint8_t {
+        nameControlFlow = 1 << 0,
+        nameBoolean = 1 << 1,
+        nameStdType = 1 << 2,
+        /** keyword in some standard, TokenList::isKeyword() decides for the current one */
+        nameKeyword = 1 << 3,
+        /** counted in TokensFrontBack::nameCount, see TokenList::nameCount() */
+        nameCounted = 1 << 4
+    };
+}
+
+/**
+ * Properties of all names that are special to update_property_info(), so
+ * that an ordinary identifier is classified with a single lookup.
+ */
+static std::unordered_map<std::string, std::uint8_t> createNameProperties()
+{
+    std::unordered_map<std::string, std::uint8_t> props;
+    for (const std::string &name : controlFlowKeywords)
+        props[name] |= nameControlFlow;
+    props["true"] |= nameBoolean;
+    props["false"] |= nameBoolean;
+    for (const std::string &name : stdTypes)
+        props[name] |= nameStdType;
+    for (const Standards::cstd_t cStd : { Standards::C89, Standards::C99, Standards::C11, Standards::C17, Standards::C23 }) {
+        for (const std::string &name : Keywords::getAll(cStd))
+            props[name] |= nameKeyword;
+    }
+    for (const Standards::cppstd_t cppStd : { Standards::CPP03, Standards::CPP11, Standards::CPP14, Standards::CPP17, Standards::CPP20, Standards::CPP23, Standards::CPP26 }) {
+        for (const std::string &name : Keywords::getAll(cppStd))
+            props[name] |= nameKeyword;
+    }
+    props["asm"] |= nameKeyword; // TODO: not a keyword
+    for (const char *name : { "asm", "__asm", "__asm__", "_asm", "__attribute__", "__attribute", "__declspec", "_declspec",
+                              "delete", "goto", "new", "operator", "sizeof", "template", "typedef", "using" })
+        props[name] |= nameCounted;
+    return props;
+}
+
+static Token::Type getOperatorType(const std::string &str, bool isLinked)
+{
+    switch (str.size()) {
+    case 1:
+        switch (str[0]) {
+        case '=':
+            return Token::eAssignmentOp;
+        case ',':
+        case '[':
+        case ']':
+        case '(':
+        case ')':
+        case '?':
+        case ':':
+            return Token::eExtendedOp;
+        case '+':
+        case '-':
+        case '*':
+        case '/':
+        case '%':
+            return Token::eArithmeticalOp;
+        case '&':
+        case '|':
+        case '^':
+        case '~':
+            return Token::eBitOp;
+        case '!':
+            return Token::eLogicalOp;
+        case '<':
+        case '>':
+            return isLinked ? Token::eBracket : Token::eComparisonOp;
+        case '{':
+        case '}':
+            return Token::eBracket;
+        }
+        break;
+    case 2:
+        if (str[1] == '=') {
+            switch (str[0]) {
+            case '+':
+            case '-':
+            case '*':
+            case '/':
+            case '%':
+            case '&':
+            case '^':
+            case '|':
+                return Token::eAssignmentOp;
+            case '=':
+            case '!':
+            case '<':
+            case '>':
+                return isLinked ? Token::eOther : Token::eComparisonOp;
+            }
+        } else if (str[0] == str[1]) {
+            switch (str[0]) {
+            case '<':
+            case '>':
+                return Token::eArithmeticalOp;
+            case '&':
+            case '|':
+                return Token::eLogicalOp;
+            case '+':
+            case '-':
+                return Token::eIncDecOp;
+            }
+        }
+        break;
+    case 3:
+        if (str == "<<=" || str == ">>=")
+            return Token::eAssignmentOp;
+        if (str == "<=>")
+            return Token::eComparisonOp;
+        if (str == "...")
+            return Token::eEllipsis;
+        break;
+    }
+    return Token::eOther;
+}
+
 void Token::update_property_info()
 {
-    setFlag(fIsControlFlowKeyword, controlFlowKeywords.find(mStr) != controlFlowKeywords.end());
+    // created on first use as the keyword tables live in another translation unit
+    static const std::unordered_map<std::string, std::uint8_t> nameProperties = createNameProperties();
+
+    std::uint8_t nameProps = 0;
+    if (!mStr.empty() && (std::isalpha((unsigned char)mStr[0]) || mStr[0] == '_')) {
+        const auto it = nameProperties.find(mStr);
+        if (it != nameProperties.end())
+            nameProps = it->second;
+    }
+
+    setFlag(fIsControlFlowKeyword, (nameProps & nameControlFlow) != 0);
+
+    if ((nameProps & nameCounted) && !mImpl->mCountedName) {
+        ++mTokensFrontBack.nameCount[mStr];
+        mImpl->mCountedName = true;
+    }
 
     if (!mStr.empty()) {
-        if (mStr == "true" || mStr == "false")
+        if (nameProps & nameBoolean)
             tokType(eBoolean);
         else if (isStringLiteral(mStr))
             tokType(eString);
@@ -114,81 +266,41 @@ void Token::update_property_info()
         else if (std::isalpha((unsigned char)mStr[0]) || mStr[0] == '_' || mStr[0] == '$') { // Name
             if (mImpl->mVarId)
                 tokType(eVariable);
-            else if (mTokensFrontBack.list.isKeyword(mStr) || mStr == "asm") // TODO: not a keyword
+            else if ((nameProps & nameKeyword) && (mStr == "asm" || mTokensFrontBack.list.isKeyword(mStr)))
                 tokType(eKeyword);
             else if (mTokType != eVariable && mTokType != eFunction && mTokType != eType && mTokType != eKeyword)
                 tokType(eName);
         } else if (simplecpp::Token::isNumberLike(mStr)) {
-            if (MathLib::isInt(mStr) || MathLib::isFloat(mStr))
+            mImpl->mIntNumberState = TokenImpl::NumberState::UNPARSED;
+            mImpl->mFloatNumberState = TokenImpl::NumberState::UNPARSED;
+            if (MathLib::isInt(mStr))
+                mImpl->mNumberType = TokenImpl::NumberType::INT;
+            else if (MathLib::isFloat(mStr))
+                mImpl->mNumberType = TokenImpl::NumberType::FLOAT;
+            else
+                mImpl->mNumberType = TokenImpl::NumberType::NONE;
+            if (mImpl->mNumberType != TokenImpl::NumberType::NONE)
                 tokType(eNumber);
             else
                 tokType(eName); // assume it is a user defined literal
-        } else if (mStr == "=" || mStr == "<<=" || mStr == ">>=" ||
-                   (mStr.size() == 2U && mStr[1] == '=' && std::strchr("+-*/%&^|", mStr[0])))
-            tokType(eAssignmentOp);
-        else if (mStr.size() == 1 && mStr.find_first_of(",[]()?:") != std::string::npos)
-            tokType(eExtendedOp);
-        else if (mStr=="<<" || mStr==">>" || (mStr.size()==1 && mStr.find_first_of("+-*/%") != std::string::npos))
-            tokType(eArithmeticalOp);
-        else if (mStr.size() == 1 && mStr.find_first_of("&|^~") != std::string::npos)
-            tokType(eBitOp);
-        else if (mStr.size() <= 2 &&
-                 (mStr == "&&" ||
-                  mStr == "||" ||
-                  mStr == "!"))
-            tokType(eLogicalOp);
-        else if (mStr.size() <= 2 && !mLink &&
-                 (mStr == "==" ||
-                  mStr == "!=" ||
-                  mStr == "<" ||
-                  mStr == "<=" ||
-                  mStr == ">" ||
-                  mStr == ">="))
-            tokType(eComparisonOp);
-        else if (mStr == "<=>")
-            tokType(eComparisonOp);
-        else if (mStr.size() == 2 &&
-                 (mStr == "++" ||
-                  mStr == "--"))
-            tokType(eIncDecOp);
-        else if (mStr.size() == 1 && (mStr.find_first_of("{}") != std::string::npos || (mLink && mStr.find_first_of("<>") != std::string::npos)))
-            tokType(eBracket);
-        else if (mStr == "...")
-            tokType(eEllipsis);
-        else
-            tokType(eOther);
+        } else {
+            tokType(getOperatorType(mStr, mLink != nullptr));
+        }
     } else {
         tokType(eNone);
     }
 
     update_property_char_string_literal();
-    update_property_isStandardType();
-}
 
-static const std::unordered_set<std::string> stdTypes = { "bool"
-                                                          , "_Bool"
-                                                          , "char"
-                                                          , "double"
-                                                          , "float"
-                                                          , "int"
-                                                          , "long"
-                                                          , "short"
-                                                          , "size_t"
-                                                          , "void"
-                                                          , "wchar_t"
-};
+    isStandardType((nameProps & nameStdType) != 0);
+    if (isStandardType())
+        tokType(eType);
+}
 
-void Token::update_property_isStandardType()
+void Token::uncountName()
 {
-    isStandardType(false);
-
-    if (mStr.size() < 3)
-        return;
-
-    if (stdTypes.find(mStr)!=stdTypes.end()) {
-        isStandardType(true);
-        tokType(eType);
-    }
+    --mTokensFrontBack.nameCount[mStr];
+    mImpl->mCountedName = false;
 }
 
 void Token::update_property_char_string_literal()
@@ -200,6 +312,42 @@ void Token::update_property_char_string_literal()
            ((mTokType == Token::eChar) && isPrefixStringCharLiteral(mStr, '\'', "L")));
 }
 
+MathLib::bigint Token::getIntNumber() const
+{
+    if (!isNumber())
+        return MathLib::toBigNumber(mStr);
+    if (mImpl->mIntNumberState == TokenImpl::NumberState::UNPARSED) {
+        try {
+            mImpl->mIntNumber = MathLib::toBigNumber(mStr);
+            mImpl->mIntNumberState = TokenImpl::NumberState::VALID;
+        } catch (const InternalError &) {
+            mImpl->mIntNumberState = TokenImpl::NumberState::INVALID;
+            throw;
+        }
+    } else if (mImpl->mIntNumberState == TokenImpl::NumberState::INVALID) {
+        return MathLib::toBigNumber(mStr); // throws the conversion error
+    }
+    return mImpl->mIntNumber;
+}
+
+double Token::getFloatNumber() const
+{
+    if (!isNumber())
+        return MathLib::toDoubleNumber(mStr);
+    if (mImpl->mFloatNumberState == TokenImpl::NumberState::UNPARSED) {
+        try {
+            mImpl->mFloatNumber = MathLib::toDoubleNumber(mStr);
+            mImpl->mFloatNumberState = TokenImpl::NumberState::VALID;
+        } catch (const InternalError &) {
+            mImpl->mFloatNumberState = TokenImpl::NumberState::INVALID;
+            throw;
+        }
+    } else if (mImpl->mFloatNumberState == TokenImpl::NumberState::INVALID) {
+        return MathLib::toDoubleNumber(mStr); // throws the conversion error
+    }
+    return mImpl->mFloatNumber;
+}
+
 bool Token::isUpperCaseName() const
 {
     if (!isName())
@@ -310,6 +458,8 @@ void Token::swapWithNext()
 
 void Token::takeData(Token *fromToken)
 {
+    if (mImpl->mCountedName)
+        uncountName();
     mStr = fromToken->mStr;
     tokType(fromToken->mTokType);
     mFlags = fromToken->mFlags;
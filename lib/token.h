@@ -134,8 +134,20 @@ struct TokenImpl {
     // For memoization, to speed up parsing of huge arrays #8897
     enum class Cpp11init : std::uint8_t { UNKNOWN, CPP11INIT, NOINIT } mCpp11init = Cpp11init::UNKNOWN;
 
+    // Number token. The type is set together with the token string and
+    // the value is converted on first use, so number tokens are parsed once.
+    enum class NumberType : std::uint8_t { NONE, INT, FLOAT } mNumberType = NumberType::NONE;
+    enum class NumberState : std::uint8_t { UNPARSED, VALID, INVALID };
+    NumberState mIntNumberState = NumberState::UNPARSED;
+    NumberState mFloatNumberState = NumberState::UNPARSED;
+    MathLib::bigint mIntNumber{};
+    double mFloatNumber{};
+
     TokenDebug mDebug{};
 
+    // Is this token counted in TokensFrontBack::nameCount
+    bool mCountedName{};
+
     void setCppcheckAttribute(CppcheckAttributes::Type type, MathLib::bigint value);
     bool getCppcheckAttribute(CppcheckAttributes::Type type, MathLib::bigint &value) const;
 
@@ -187,6 +199,8 @@ public:
 
     template<typename T>
     void str(T&& s) {
+        if (mImpl->mCountedName)
+            uncountName();
         mStr = s;
         mImpl->mVarId = 0;
 
@@ -392,6 +406,26 @@ public:
     bool isNumber() const {
         return mTokType == eNumber;
     }
+    /** @return true if this is an integer literal, see MathLib::isInt() */
+    bool isIntNumber() const {
+        return mTokType == eNumber && mImpl->mNumberType == TokenImpl::NumberType::INT;
+    }
+    /** @return true if this is a floating point literal, see MathLib::isFloat() */
+    bool isFloatNumber() const {
+        return mTokType == eNumber && mImpl->mNumberType == TokenImpl::NumberType::FLOAT;
+    }
+    /**
+     * Value of a literal, same as MathLib::toBigNumber(str()).
+     * The literal is only converted the first time.
+     * @throws InternalError if the literal can't be converted
+     */
+    MathLib::bigint getIntNumber() const;
+    /**
+     * Value of a literal, same as MathLib::toDoubleNumber(str()).
+     * The literal is only converted the first time.
+     * @throws InternalError if the literal can't be converted
+     */
+    double getFloatNumber() const;
     bool isEnumerator() const {
         return mTokType == eEnumerator;
     }
@@ -1415,8 +1449,8 @@ private:
         Called after any mStr() modification. */
     void update_property_info();
 
-    /** Update internal property cache about isStandardType() */
-    void update_property_isStandardType();
+    /** Remove this token from TokensFrontBack::nameCount. Called before mStr is changed. */
+    void uncountName();
 
     /** Update internal property cache about string and char literals */
     void update_property_char_string_literal();
@@ -44,6 +44,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <initializer_list>
 #include <iostream>
 #include <iterator>
 #include <exception>
@@ -558,7 +559,7 @@ Token *Tokenizer::processFunc(Token *tok2, bool inOperator)
 
 void Tokenizer::simplifyUsingToTypedef()
 {
-    if (!isCPP() || mSettings.standards.cpp < Standards::CPP11)
+    if (!isCPP() || mSettings.standards.cpp < Standards::CPP11 || list.nameCount("using") == 0)
         return;
 
     for (Token *tok = list.front(); tok; tok = tok->next()) {
@@ -1073,6 +1074,11 @@ namespace {
 
 void Tokenizer::simplifyTypedef()
 {
+    if (list.nameCount("typedef") == 0) {
+        simplifyTypedefCpp();
+        return;
+    }
+
     // Simplify global typedefs that are not redefined with the fast 1-pass simplification.
     // Then use the slower old typedef simplification.
     std::map<std::string, int> numberOfTypedefs;
@@ -1168,8 +1174,21 @@ void Tokenizer::simplifyTypedefCpp()
     // Convert "using a::b;" to corresponding typedef statements
     simplifyUsingToTypedef();
 
+    if (list.nameCount("typedef") == 0)
+        return;
+
     const std::time_t maxTime = mSettings.typedefMaxTime > 0 ? std::time(nullptr) + mSettings.typedefMaxTime: 0;
 
+    // Number of tokens for each name. The forward scan for the uses of a
+    // typedef is skipped when its name only occurs in the typedef itself.
+    // Counts are never decreased and new tokens are copies of existing
+    // tokens, so every name in the token list is counted.
+    std::unordered_map<std::string, int> nameCount;
+    for (const Token *tok = list.front(); tok; tok = tok->next()) {
+        if (tok->isName())
+            ++nameCount[tok->str()];
+    }
+
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (!list.getFiles().empty())
             mErrorLogger.reportProgress(list.getFiles()[0], "Tokenize (typedef)", tok->progressValue());
@@ -1644,6 +1663,9 @@ void Tokenizer::simplifyTypedefCpp()
         mTypedefInfo.push_back(std::move(typedefInfo));
 
         while (!done) {
+            const auto nameIt = nameCount.find(typeName->str());
+            const bool hasUses = nameIt == nameCount.end() || nameIt->second > 1;
+
             std::string pattern = typeName->str();
             int scope = 0;
             bool simplifyType = false;
@@ -1661,7 +1683,7 @@ void Tokenizer::simplifyTypedefCpp()
                 classPath += spaceInfo[i].className;
             }
 
-            for (Token *tok2 = tok; tok2; tok2 = tok2->next()) {
+            for (Token *tok2 = hasUses ? tok : nullptr; tok2; tok2 = tok2->next()) {
                 if (Settings::terminated())
                     return;
 
@@ -4337,7 +4359,7 @@ static bool setVarIdParseDeclaration(Token*& tok, const VariableMap& variableMap
 
 
 static void setVarIdStructMembers(Token *&tok1,
-                                  std::map<nonneg int, std::map<std::string, nonneg int>>& structMembers,
+                                  std::unordered_map<nonneg int, std::unordered_map<std::string, nonneg int>>& structMembers,
                                   nonneg int &varId)
 {
     Token *tok = tok1;
@@ -4347,7 +4369,7 @@ static void setVarIdStructMembers(Token *&tok1,
         if (struct_varid == 0)
             return;
 
-        std::map<std::string, nonneg int>& members = structMembers[struct_varid];
+        std::unordered_map<std::string, nonneg int>& members = structMembers[struct_varid];
 
         tok = tok->tokAt(3);
         while (tok->str() != "}") {
@@ -4355,7 +4377,7 @@ static void setVarIdStructMembers(Token *&tok1,
                 tok = tok->link();
             if (Token::Match(tok->previous(), "[,{] . %name% =|{")) {
                 tok = tok->next();
-                const std::map<std::string, nonneg int>::iterator it = members.find(tok->str());
+                const std::unordered_map<std::string, nonneg int>::iterator it = members.find(tok->str());
                 if (it == members.end()) {
                     members[tok->str()] = ++varId;
                     tok->varId(varId);
@@ -4388,8 +4410,8 @@ static void setVarIdStructMembers(Token *&tok1,
         if (TemplateSimplifier::templateParameters(tok->next()) > 0)
             break;
 
-        std::map<std::string, nonneg int>& members = structMembers[struct_varid];
-        const std::map<std::string, nonneg int>::iterator it = members.find(tok->str());
+        std::unordered_map<std::string, nonneg int>& members = structMembers[struct_varid];
+        const std::unordered_map<std::string, nonneg int>::iterator it = members.find(tok->str());
         if (it == members.end()) {
             members[tok->str()] = ++varId;
             tok->varId(varId);
@@ -4404,7 +4426,7 @@ static void setVarIdStructMembers(Token *&tok1,
 static bool setVarIdClassDeclaration(Token* const startToken,
                                      VariableMap& variableMap,
                                      const nonneg int scopeStartVarId,
-                                     std::map<nonneg int, std::map<std::string, nonneg int>>& structMembers)
+                                     std::unordered_map<nonneg int, std::unordered_map<std::string, nonneg int>>& structMembers)
 {
     // end of scope
     const Token* const endToken = startToken->link();
@@ -4483,8 +4505,8 @@ static bool setVarIdClassDeclaration(Token* const startToken,
 void Tokenizer::setVarIdClassFunction(const std::string &classname,
                                       Token * const startToken,
                                       const Token * const endToken,
-                                      const std::map<std::string, nonneg int> &varlist,
-                                      std::map<nonneg int, std::map<std::string, nonneg int>>& structMembers,
+                                      const std::unordered_map<std::string, nonneg int> &varlist,
+                                      std::unordered_map<nonneg int, std::unordered_map<std::string, nonneg int>>& structMembers,
                                       nonneg int &varId_)
 {
     const auto pos = classname.rfind(' '); // TODO handle multiple scopes
@@ -4501,7 +4523,7 @@ void Tokenizer::setVarIdClassFunction(const std::string &classname,
         if (Token::Match(tok2, "%name% ::"))
             continue;
 
-        const std::map<std::string, nonneg int>::const_iterator it = varlist.find(tok2->str());
+        const std::unordered_map<std::string, nonneg int>::const_iterator it = varlist.find(tok2->str());
         if (it != varlist.end()) {
             tok2->varId(it->second);
             setVarIdStructMembers(tok2, structMembers, varId_);
@@ -4541,7 +4563,7 @@ void Tokenizer::setVarIdPass1()
     const std::unordered_set<std::string>& notstart = (isC()) ? notstart_c : notstart_cpp;
 
     VariableMap variableMap;
-    std::map<nonneg int, std::map<std::string, nonneg int>> structMembers;
+    std::unordered_map<nonneg int, std::unordered_map<std::string, nonneg int>> structMembers;
 
     std::stack<VarIdScopeInfo> scopeStack;
 
@@ -5024,7 +5046,7 @@ static T* skipInitializerList(T* tok)
 
 void Tokenizer::setVarIdPass2()
 {
-    std::map<nonneg int, std::map<std::string, nonneg int>> structMembers;
+    std::unordered_map<nonneg int, std::unordered_map<std::string, nonneg int>> structMembers;
 
     // Member functions and variables in this source
     std::list<Member> allMemberFunctions;
@@ -5092,7 +5114,7 @@ void Tokenizer::setVarIdPass2()
     std::list<ScopeInfo2> scopeInfo;
 
     // class members..
-    std::map<std::string, std::map<std::string, nonneg int>> varsByClass;
+    std::unordered_map<std::string, std::unordered_map<std::string, nonneg int>> varsByClass;
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         while (tok->str() == "}" && !scopeInfo.empty() && tok == scopeInfo.back().bodyEnd)
             scopeInfo.pop_back();
@@ -5124,7 +5146,7 @@ void Tokenizer::setVarIdPass2()
         for (const Token *it : classnameTokens)
             classname += (classname.empty() ? "" : " :: ") + it->str();
 
-        std::map<std::string, nonneg int> &thisClassVars = varsByClass[scopeName2 + classname];
+        std::unordered_map<std::string, nonneg int> &thisClassVars = varsByClass[scopeName2 + classname];
         while (Token::Match(tokStart, ":|::|,|%name%")) {
             if (Token::Match(tokStart, "%name% <")) { // TODO: why skip templates?
                 tokStart = tokStart->next()->findClosingBracket();
@@ -5155,7 +5177,7 @@ void Tokenizer::setVarIdPass2()
                         break;
                     scopeName3.erase(pos + 4);
                 }
-                const std::map<std::string, nonneg int>& baseClassVars = varsByClass[baseClassName];
+                const std::unordered_map<std::string, nonneg int>& baseClassVars = varsByClass[baseClassName];
                 thisClassVars.insert(baseClassVars.cbegin(), baseClassVars.cend());
             }
             tokStart = tokStart->next();
@@ -5251,7 +5273,7 @@ void Tokenizer::setVarIdPass2()
                     break;
 
                 // set varid
-                const std::map<std::string, nonneg int>::const_iterator varpos = thisClassVars.find(tok3->str());
+                const std::unordered_map<std::string, nonneg int>::const_iterator varpos = thisClassVars.find(tok3->str());
                 if (varpos != thisClassVars.end())
                     tok3->varId(varpos->second);
 
@@ -5525,6 +5547,8 @@ bool Tokenizer::simplifyTokenList1(const char FileName[])
 
     simplifyHeadersAndUnusedTemplates();
 
+    removeUnchangedFunctionBodies();
+
     // Remove __asm..
     simplifyAsm();
 
@@ -6015,9 +6039,9 @@ void Tokenizer::dump(std::ostream &out) const
                 outs += " isSigned=\"true\"";
         } else if (tok->isNumber()) {
             outs += " type=\"number\"";
-            if (MathLib::isInt(tok->str()))
+            if (tok->isIntNumber())
                 outs += " isInt=\"true\"";
-            if (MathLib::isFloat(tok->str()))
+            if (tok->isFloatNumber())
                 outs += " isFloat=\"true\"";
         } else if (tok->tokType() == Token::eString) {
             outs += " type=\"string\" strlen=\"";
@@ -6215,7 +6239,18 @@ void Tokenizer::dump(std::ostream &out) const
 
 void Tokenizer::simplifyHeadersAndUnusedTemplates()
 {
-    if (mSettings.checkHeaders && mSettings.checkUnusedTemplates)
+    // Headers where all messages are suppressed. Only declarations and the
+    // functions that are used elsewhere are kept in these.
+    std::vector<bool> reducedFiles(list.getFiles().size(), false);
+    bool hasReducedFiles = false;
+    if (mSettings.reduceSuppressedHeaders && mSettings.checkHeaders) {
+        for (std::size_t i = 1; i < reducedFiles.size(); ++i) {
+            reducedFiles[i] = mSettings.supprs.nomsg.isSuppressedFile(list.getFiles()[i]);
+            hasReducedFiles |= reducedFiles[i];
+        }
+    }
+
+    if (mSettings.checkHeaders && mSettings.checkUnusedTemplates && !hasReducedFiles)
         // Full analysis. All information in the headers are kept.
         return;
 
@@ -6248,7 +6283,7 @@ void Tokenizer::simplifyHeadersAndUnusedTemplates()
         if (!tok->isName() || tok->isKeyword())
             continue;
 
-        if (!checkHeaders && tok->fileIndex() != 0)
+        if ((!checkHeaders || reducedFiles[tok->fileIndex()]) && tok->fileIndex() != 0)
             continue;
 
         if (Token::Match(tok, "%name% (") && !Token::simpleMatch(tok->linkAt(1), ") {")) {
@@ -6267,12 +6302,13 @@ void Tokenizer::simplifyHeadersAndUnusedTemplates()
         const bool isIncluded = (tok->fileIndex() != 0);
 
         // Remove executable code
-        if (isIncluded && !mSettings.checkHeaders && tok->str() == "{") {
+        if (isIncluded && (!checkHeaders || reducedFiles[tok->fileIndex()]) && tok->str() == "{") {
             // TODO: We probably need to keep the executable code if this function is called from the source file.
             const Token *prev = tok->previous();
             while (prev && prev->isName())
                 prev = prev->previous();
-            if (Token::simpleMatch(prev, ")")) {
+            if (Token::simpleMatch(prev, ")") &&
+                (!checkHeaders || !Token::Match(prev->link()->previous(), "%name% (") || keep.find(prev->link()->strAt(-1)) == keep.end())) {
                 // Replace all tokens from { to } with a ";".
                 Token::eraseTokens(tok,tok->link()->next());
                 tok->str(";");
@@ -6338,6 +6374,208 @@ void Tokenizer::simplifyHeadersAndUnusedTemplates()
     }
 }
 
+/**
+ * If tok is the "{" of a namespace, class, struct, union or extern "C"
+ * block then return the keyword token, otherwise nullptr.
+ */
+static const Token *findDeclarationScopeKeyword(const Token *tok)
+{
+    for (const Token *prev = tok->previous(); prev && !Token::Match(prev, "[;{}]"); prev = prev->previous()) {
+        if (prev->str() == ")" || prev->str() == "]")
+            prev = prev->link();
+        if (Token::Match(prev, "class|struct|union|namespace") || Token::Match(prev, "extern %str%"))
+            return prev;
+    }
+    return nullptr;
+}
+
+/** Is the name used to refer to a declaration? */
+static bool isDependencyName(const Token *tok)
+{
+    return tok->isName() && !tok->isKeyword() && !tok->isStandardType();
+}
+
+void Tokenizer::removeUnchangedFunctionBodies()
+{
+    mFunctionBodies.clear();
+    if (mSettings.diff.empty() && !mKnownFunctionResults)
+        return;
+
+    struct Body {
+        Token *start;
+        /** function name, empty if this is not a plain function body */
+        std::string name;
+        /** the names used in the body */
+        std::set<std::string> names;
+        /** hash of the tokens from the start of the declaration to the end of the body */
+        std::uint64_t tokensHash;
+        FunctionBody function;
+        /** the body is in a class definition */
+        bool inClass;
+        bool changed;
+    };
+    std::vector<Body> bodies;
+
+    // The hashes of the declarations outside the bodies by the names in them
+    std::unordered_map<std::string, std::vector<std::uint64_t>> declarations;
+    StableHash declaration;
+    std::set<std::string> declarationNames;
+    const auto endDeclaration = [&]() {
+        if (!declarationNames.empty()) {
+            const std::uint64_t hash = declaration.digest();
+            for (const std::string &name : declarationNames)
+                declarations[name].push_back(hash);
+            declarationNames.clear();
+        }
+        declaration = StableHash();
+    };
+
+    // ends of the declaration scopes, and whether it is a class scope
+    std::vector<std::pair<const Token *, bool>> scopes;
+
+    // Collect the bodies at namespace and class level
+    for (Token *tok = list.front(); tok; tok = tok->next()) {
+        if (!scopes.empty() && tok == scopes.back().first)
+            scopes.pop_back();
+        if (tok->str() != "{") {
+            if (mKnownFunctionResults) {
+                if (Token::Match(tok, "[;}]")) {
+                    endDeclaration();
+                } else {
+                    declaration.update(tok->str());
+                    if (isDependencyName(tok))
+                        declarationNames.insert(tok->str());
+                }
+            }
+            continue;
+        }
+        if (const Token *keyword = findDeclarationScopeKeyword(tok)) {
+            if (mKnownFunctionResults)
+                endDeclaration();
+            // look for the member function bodies
+            scopes.emplace_back(tok->link(), Token::Match(keyword, "class|struct|union"));
+            continue;
+        }
+
+        const Token *prev = tok->previous();
+        while (Token::Match(prev, "const|volatile|noexcept|override|final|&|&&"))
+            prev = prev->previous();
+        const Token *name = nullptr;
+        if (Token::simpleMatch(prev, ")") && Token::Match(prev->link()->previous(), "%name% (") &&
+            !Token::Match(prev->link()->previous(), "if|for|while|switch|catch|return|sizeof|decltype|noexcept|throw|__attribute__|__declspec") &&
+            !Token::Match(prev->link()->tokAt(-2), ":|,")) // the body of a constructor with member initializers is kept
+            name = prev->link()->previous();
+
+        // the lines from the start of the declaration to the end of the body
+        const Token *first = name ? name : tok;
+        while (first->previous() && !Token::Match(first->previous(), "[;{}:]"))
+            first = first->previous();
+        const Token *end = tok->link();
+
+        Body body{tok, name ? name->str() : std::string(), {}, 0, {}, !scopes.empty() && scopes.back().second, true};
+        body.function.file = list.getFiles()[first->fileIndex()];
+        body.function.first = first->linenr();
+        body.function.last = std::max(first->linenr(), end->linenr());
+        if (!mSettings.diff.empty())
+            body.changed = mSettings.diff.isChanged(body.function.file, body.function.first, body.function.last);
+
+        for (const Token *tok2 = tok->next(); tok2 != end; tok2 = tok2->next()) {
+            if (tok2->isName())
+                body.names.insert(tok2->str());
+        }
+
+        if (mKnownFunctionResults) {
+            StableHash tokensHash;
+            for (const Token *tok2 = first; tok2 != end->next(); tok2 = tok2->next())
+                tokensHash.update(tok2->str()).update(tok2->getMacroName());
+            body.tokensHash = tokensHash.digest();
+
+            if (name) {
+                endDeclaration();
+            } else {
+                // initializers and such are part of the declaration
+                for (const Token *tok2 = tok; tok2 != end->next(); tok2 = tok2->next()) {
+                    declaration.update(tok2->str());
+                    if (isDependencyName(tok2))
+                        declarationNames.insert(tok2->str());
+                }
+            }
+        }
+        bodies.push_back(std::move(body));
+        tok = tok->link();
+    }
+
+    if (mKnownFunctionResults) {
+        // The results of a function depend on its own code, the declarations it
+        // uses and the code of the functions it calls and is called by
+        std::unordered_map<std::string, std::vector<const Body *>> bodiesByName;
+        std::unordered_map<std::string, std::vector<const Body *>> bodiesByUsedName;
+        for (const Body &body : bodies) {
+            if (!body.name.empty())
+                bodiesByName[body.name].push_back(&body);
+            for (const std::string &name : body.names)
+                bodiesByUsedName[name].push_back(&body);
+        }
+
+        for (Body &body : bodies) {
+            std::set<std::uint64_t> dependencies;
+            for (const std::string &name : body.names) {
+                const auto decl = declarations.find(name);
+                if (decl != declarations.end())
+                    dependencies.insert(decl->second.cbegin(), decl->second.cend());
+                const auto callees = bodiesByName.find(name);
+                if (callees != bodiesByName.end()) {
+                    for (const Body *callee : callees->second)
+                        dependencies.insert(callee->tokensHash);
+                }
+            }
+            const auto callers = bodiesByUsedName.find(body.name);
+            if (!body.name.empty() && callers != bodiesByUsedName.end()) {
+                for (const Body *caller : callers->second)
+                    dependencies.insert(caller->tokensHash);
+            }
+
+            StableHash hash;
+            hash.update(body.function.file).update(body.tokensHash);
+            for (const std::uint64_t dependency : dependencies)
+                hash.update(dependency);
+            body.function.hash = hash.digest();
+
+            // the bodies in class definitions are always checked
+            if (body.changed && !body.name.empty() && !body.inClass)
+                body.changed = !mKnownFunctionResults(body.function);
+        }
+    }
+
+    // names of the changed functions and names used in them
+    std::set<std::string> changedFunctions;
+    std::set<std::string> usedNames;
+    for (const Body &body : bodies) {
+        if (!body.changed)
+            continue;
+        if (!body.name.empty())
+            changedFunctions.insert(body.name);
+        usedNames.insert(body.names.cbegin(), body.names.cend());
+    }
+
+    for (Body &body : bodies) {
+        // keep the changed functions and their direct callees and callers
+        const bool keep = body.changed || body.name.empty() || usedNames.count(body.name) > 0 ||
+                          std::any_of(body.names.cbegin(), body.names.cend(), [&](const std::string &name) {
+            return changedFunctions.count(name) > 0;
+        });
+        if (!keep) {
+            // Replace all tokens from { to } with a ";".
+            Token::eraseTokens(body.start, body.start->link()->next());
+            body.start->str(";");
+            body.start->link(nullptr);
+            body.function.removed = true;
+        }
+        if (mKnownFunctionResults && !body.name.empty() && !body.inClass)
+            mFunctionBodies.push_back(std::move(body.function));
+    }
+}
+
 void Tokenizer::removeExtraTemplateKeywords()
 {
     if (isCPP()) {
@@ -9132,6 +9370,13 @@ void Tokenizer::simplifyCallingConvention()
     }
 }
 
+/** Is any of the given names used in the token list, see TokenList::nameCount() */
+static bool hasAnyName(const TokenList &list, std::initializer_list<const char *> names) {
+    return std::any_of(names.begin(), names.end(), [&](const char *name) {
+        return list.nameCount(name) > 0;
+    });
+}
+
 static bool isAttribute(const Token* tok, bool gcc) {
     return gcc ? Token::Match(tok, "__attribute__|__attribute (") : Token::Match(tok, "__declspec|_declspec (");
 }
@@ -9184,6 +9429,9 @@ Token* Tokenizer::getAttributeFuncTok(Token* tok, bool gccattr) const {
 
 void Tokenizer::simplifyDeclspec()
 {
+    if (!hasAnyName(list, { "__declspec", "_declspec" }))
+        return;
+
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         while (isAttribute(tok, false)) {
             if (Token::Match(tok->tokAt(2), "noreturn|nothrow|dllexport")) {
@@ -9646,6 +9894,9 @@ void Tokenizer::simplifyAssignmentBlock()
 // Remove __asm..
 void Tokenizer::simplifyAsm()
 {
+    if (!hasAnyName(list, { "asm", "__asm", "__asm__", "_asm" }))
+        return;
+
     std::string instruction;
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "__asm|_asm|asm {") &&
@@ -25,10 +25,13 @@
 #include "tokenlist.h"
 
 #include <cstdint>
+#include <functional>
 #include <iosfwd>
 #include <list>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 class Settings;
@@ -61,6 +64,32 @@ public:
         mTimerResults = tr;
     }
 
+    /** @brief A function body, for the function results cache (--function-cache) */
+    struct FunctionBody {
+        std::string file;
+        /** first line of the declaration */
+        int first{};
+        /** line of the closing brace */
+        int last{};
+        /** hash of the function and the code it depends on */
+        std::uint64_t hash{};
+        /** the body was removed because its results are known */
+        bool removed{};
+    };
+
+    /**
+     * Set the callback that tells if the results of a function are known.
+     * Such function bodies are removed like the unchanged bodies of --diff.
+     */
+    void setKnownFunctionResults(std::function<bool(const FunctionBody &)> known) {
+        mKnownFunctionResults = std::move(known);
+    }
+
+    /** The function bodies that were considered for removal, when there is a known function results callback */
+    const std::vector<FunctionBody> &functionBodies() const {
+        return mFunctionBodies;
+    }
+
     /** Is the code C. Used for bailouts */
     bool isC() const {
         return list.isC();
@@ -105,6 +134,14 @@ private:
      */
     void simplifyHeadersAndUnusedTemplates();
 
+    /**
+     * If --diff has been given; then remove the bodies of the functions
+     * which are not changed and which do not call or are not called by
+     * a changed function. Functions with known results are treated as
+     * unchanged.
+     */
+    void removeUnchangedFunctionBodies();
+
     /**
      * Remove extra "template" keywords that are not used by Cppcheck
      */
@@ -546,8 +583,8 @@ private:
     static void setVarIdClassFunction(const std::string &classname,
                                       Token * const startToken,
                                       const Token * const endToken,
-                                      const std::map<std::string, nonneg int> &varlist,
-                                      std::map<nonneg int, std::map<std::string, nonneg int>>& structMembers,
+                                      const std::unordered_map<std::string, nonneg int> &varlist,
+                                      std::unordered_map<nonneg int, std::unordered_map<std::string, nonneg int>>& structMembers,
                                       nonneg int &varId_);
 
     /**
@@ -681,6 +718,10 @@ private:
      * TimerResults
      */
     TimerResults* mTimerResults{};
+
+    std::function<bool(const FunctionBody &)> mKnownFunctionResults;
+
+    std::vector<FunctionBody> mFunctionBodies;
 };
 
 /// @}
@@ -30,14 +30,15 @@
 #include "settings.h"
 #include "standards.h"
 #include "token.h"
+#include "utils.h"
 
 #include <cctype>
 #include <exception>
 #include <functional>
 #include <utility>
-#include <set>
 #include <stack>
 #include <unordered_set>
+#include <vector>
 
 #include <simplecpp.h>
 
@@ -124,6 +125,12 @@ int TokenList::appendFileIfNew(std::string fileName)
     return mFiles.size() - 1;
 }
 
+nonneg int TokenList::nameCount(const std::string &name) const
+{
+    const auto it = mTokensFrontBack.nameCount.find(name);
+    return it == mTokensFrontBack.nameCount.end() ? 0 : it->second;
+}
+
 void TokenList::clangSetOrigFiles()
 {
     mOrigFiles = mFiles;
@@ -422,17 +429,17 @@ void TokenList::createTokens(simplecpp::TokenList&& tokenList)
 
 //---------------------------------------------------------------------------
 
-std::size_t TokenList::calculateHash() const
+std::uint64_t TokenList::calculateHash() const
 {
-    std::string hashData;
+    StableHash hash;
     for (const Token* tok = front(); tok; tok = tok->next()) {
-        hashData += std::to_string(tok->flags());
-        hashData += std::to_string(tok->varId());
-        hashData += std::to_string(tok->tokType());
-        hashData += tok->str();
-        hashData += tok->originalName();
+        hash.update(tok->flags());
+        hash.update(tok->varId());
+        hash.update(static_cast<std::uint64_t>(tok->tokType()));
+        hash.update(tok->str());
+        hash.update(tok->originalName());
     }
-    return (std::hash<std::string>{})(hashData);
+    return hash.digest();
 }
 
 
@@ -440,7 +447,7 @@ std::size_t TokenList::calculateHash() const
 
 namespace {
     struct AST_state {
-        std::stack<Token*> op;
+        std::stack<Token*, std::vector<Token*>> op;
         int depth{};
         int inArrayAssignment{};
         bool cpp;
@@ -1808,7 +1815,12 @@ void TokenList::validateAst(bool print) const
                 mTokensFrontBack.front->printOut();
         }};
     // Check for some known issues in AST to avoid crash/hang later on
-    std::set<const Token*> safeAstTokens;    // list of "safe" AST tokens without endless recursion
+    std::size_t tokenCount = 0;
+    for (const Token *tok = mTokensFrontBack.front; tok; tok = tok->next())
+        ++tokenCount;
+    std::unordered_set<const Token*> safeAstTokens;    // "safe" AST tokens without endless recursion
+    safeAstTokens.reserve(tokenCount);
+    std::vector<const Token*> astTokens;    // ancestors of the current token
     for (const Token *tok = mTokensFrontBack.front; tok; tok = tok->next()) {
         // Syntax error if binary operator only has 1 operand
         if ((tok->isAssignmentOp() || tok->isComparisonOp() || Token::Match(tok,"[|^/%]")) && tok->astOperand1() && !tok->astOperand2())
@@ -1825,18 +1837,16 @@ void TokenList::validateAst(bool print) const
         // Check for endless recursion
         const Token* parent = tok->astParent();
         if (parent) {
-            std::set<const Token*> astTokens;    // list of ancestors
-            astTokens.insert(tok);
+            astTokens.assign(1, tok);
             do {
                 if (safeAstTokens.find(parent) != safeAstTokens.end())
                     break;
-                if (astTokens.find(parent) != astTokens.end())
+                // there can only be more ancestors than tokens if they form a loop
+                if (astTokens.size() > tokenCount)
                     throw InternalError(tok, "AST broken: endless recursion from '" + tok->str() + "'", InternalError::AST);
-                astTokens.insert(parent);
+                astTokens.push_back(parent);
             } while ((parent = parent->astParent()) != nullptr);
             safeAstTokens.insert(astTokens.cbegin(), astTokens.cend());
-        } else if (tok->str() == ";") {
-            safeAstTokens.clear();
         } else {
             safeAstTokens.insert(tok);
         }
@@ -25,8 +25,10 @@
 #include "standards.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class Token;
@@ -48,6 +50,8 @@ struct TokensFrontBack {
     Token *front{};
     Token* back{};
     const TokenList& list;
+    /** number of tokens for each of the names counted by Token */
+    std::unordered_map<std::string, nonneg int> nameCount;
 };
 
 class CPPCHECKLIB TokenList {
@@ -134,6 +138,15 @@ public:
         return mTokensFrontBack.back;
     }
 
+    /**
+     * Number of tokens with given name. This is only maintained for
+     * some rare names that passes look for: asm, __asm, __asm__, _asm,
+     * __attribute__, __attribute, __declspec, _declspec, delete, goto,
+     * new, operator, sizeof, template, typedef and using.
+     * A pass can be skipped when the name it looks for is not used.
+     */
+    nonneg int nameCount(const std::string &name) const;
+
     /**
      * Get filenames (the sourcefile + the files it include).
      * The first filename is the filename for the sourcefile
@@ -163,7 +176,7 @@ public:
      * Calculates a hash of the token list used to compare multiple
      * token lists with each other as quickly as possible.
      */
-    std::size_t calculateHash() const;
+    std::uint64_t calculateHash() const;
 
     /**
      * Create abstract syntax tree.
@@ -147,3 +147,60 @@ void findAndReplace(std::string &source, const std::string &searchFor, const std
         index += replaceWith.length();
     }
 }
+
+static constexpr std::uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+static constexpr std::uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr std::uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+static constexpr std::uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr std::uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+static std::uint64_t rotl64(std::uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+StableHash::StableHash(std::uint64_t seed)
+    : mAcc(seed + PRIME64_5)
+{}
+
+void StableHash::addByte(unsigned char c)
+{
+    const int shift = static_cast<int>(mLength & 7) * 8;
+    mLane |= static_cast<std::uint64_t>(c) << shift;
+    ++mLength;
+    if ((mLength & 7) == 0) {
+        // same lane mixing as xxHash64
+        mAcc ^= rotl64(mLane * PRIME64_2, 31) * PRIME64_1;
+        mAcc = rotl64(mAcc, 27) * PRIME64_1 + PRIME64_4;
+        mLane = 0;
+    }
+}
+
+StableHash& StableHash::update(const char *data, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i)
+        addByte(static_cast<unsigned char>(data[i]));
+    return *this;
+}
+
+StableHash& StableHash::update(std::uint64_t value)
+{
+    for (int i = 0; i < 8; ++i)
+        addByte(static_cast<unsigned char>(value >> (8 * i)));
+    return *this;
+}
+
+std::uint64_t StableHash::digest() const
+{
+    std::uint64_t h = mAcc + mLength;
+    if ((mLength & 7) != 0) {
+        h ^= mLane * PRIME64_5;
+        h = rotl64(h, 11) * PRIME64_1;
+    }
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
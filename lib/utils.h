@@ -364,6 +364,35 @@ CPPCHECKLIB std::string trim(const std::string& s, const std::string& t = " \t")
  */
 CPPCHECKLIB void findAndReplace(std::string &source, const std::string &searchFor, const std::string &replaceWith);
 
+/**
+ * Streaming 64-bit hash that gives the same result on every platform and
+ * in every build, so it can be used for keys that are stored on disk.
+ *
+ * Data is hashed as a byte stream: integers are fed as 8 bytes in little
+ * endian order and strings as their length (fed as an integer) followed by
+ * their characters. Nothing is buffered beyond the current 8-byte lane.
+ */
+class CPPCHECKLIB StableHash {
+public:
+    explicit StableHash(std::uint64_t seed = 0);
+
+    StableHash& update(const char *data, std::size_t size);
+    StableHash& update(std::uint64_t value);
+    StableHash& update(const std::string &str) {
+        update(static_cast<std::uint64_t>(str.size()));
+        return update(str.data(), str.size());
+    }
+
+    std::uint64_t digest() const;
+
+private:
+    void addByte(unsigned char c);
+
+    std::uint64_t mAcc;
+    std::uint64_t mLane{};
+    std::uint64_t mLength{};
+};
+
 namespace cppcheck
 {
     NORETURN inline void unreachable()
@@ -89,6 +89,7 @@
 #include "infer.h"
 #include "library.h"
 #include "mathlib.h"
+#include "memoryusage.h"
 #include "path.h"
 #include "platform.h"
 #include "programmemory.h"
@@ -783,9 +784,9 @@ static void valueFlowBitAnd(TokenList &tokenlist, const Settings& settings)
 
         MathLib::bigint number;
         if (MathLib::isInt(tok->astOperand1()->str()))
-            number = MathLib::toBigNumber(tok->astOperand1()->str());
+            number = tok->astOperand1()->getIntNumber();
         else if (MathLib::isInt(tok->astOperand2()->str()))
-            number = MathLib::toBigNumber(tok->astOperand2()->str());
+            number = tok->astOperand2()->getIntNumber();
         else
             continue;
 
@@ -8492,6 +8493,9 @@ struct ValueFlowPassRunner {
             // TODO: add bailout message
             return true;
         }
+        // the bailout message is reported when the analysis of the file is done
+        if (MemoryUsage::limitExceeded())
+            return true;
         if (!state.tokenlist.isCPP() && pass->cpp())
             return false;
         if (timerResults) {
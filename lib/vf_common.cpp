@@ -117,9 +117,9 @@ namespace ValueFlow
     // Handle various constants..
     Token * valueFlowSetConstantValue(Token *tok, const Settings &settings)
     {
-        if ((tok->isNumber() && MathLib::isInt(tok->str())) || (tok->tokType() == Token::eChar)) {
+        if (tok->isIntNumber() || (tok->tokType() == Token::eChar)) {
             try {
-                MathLib::bigint signedValue = MathLib::toBigNumber(tok->str());
+                MathLib::bigint signedValue = tok->getIntNumber();
                 const ValueType* vt = tok->valueType();
                 if (vt && vt->sign == ValueType::UNSIGNED && signedValue < 0 && getSizeOf(*vt, settings) < sizeof(MathLib::bigint)) {
                     MathLib::bigint minValue{}, maxValue{};
@@ -133,10 +133,10 @@ namespace ValueFlow
             } catch (const std::exception & /*e*/) {
                 // Bad character literal
             }
-        } else if (tok->isNumber() && MathLib::isFloat(tok->str())) {
+        } else if (tok->isFloatNumber()) {
             Value value;
             value.valueType = Value::ValueType::FLOAT;
-            value.floatValue = MathLib::toDoubleNumber(tok->str());
+            value.floatValue = tok->getFloatNumber();
             if (!tok->isTemplateArg())
                 value.setKnown();
             setTokenValue(tok, std::move(value), settings);
@@ -288,7 +288,7 @@ namespace ValueFlow
                 const Token* brac = tok2->astParent();
                 while (Token::simpleMatch(brac, "[")) {
                     const Token* num = brac->astOperand2();
-                    if (num && ((num->isNumber() && MathLib::isInt(num->str())) || num->tokType() == Token::eChar)) {
+                    if (num && (num->isIntNumber() || num->tokType() == Token::eChar)) {
                         try {
                             const MathLib::biguint dim = MathLib::toBigUNumber(num->str());
                             sz *= dim;
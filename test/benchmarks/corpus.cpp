@@ -0,0 +1,106 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "corpus.h"
+
+#include <fstream>
+#include <sstream>
+
+std::string generateCode(int size)
+{
+    std::ostringstream code;
+    code << "#include <string>\n"
+         << "#include <vector>\n"
+         << "\n"
+         << "struct Point {\n"
+         << "    int x;\n"
+         << "    int y;\n"
+         << "};\n"
+         << "\n"
+         << "template<class T>\n"
+         << "T clamp(T v, T lo, T hi) {\n"
+         << "    return v < lo ? lo : (v > hi ? hi : v);\n"
+         << "}\n"
+         << "\n";
+
+    for (int i = 0; i < size; ++i) {
+        code << "class Widget" << i << " {\n"
+             << "public:\n"
+             << "    explicit Widget" << i << "(int n) : mSize(n) {}\n"
+             << "    int size() const { return mSize; }\n"
+             << "    void add(const Point &p) { mPoints.push_back(p); }\n"
+             << "    int sum() const;\n"
+             << "    std::string name() const { return mName + std::to_string(mSize); }\n"
+             << "private:\n"
+             << "    int mSize;\n"
+             << "    std::string mName;\n"
+             << "    std::vector<Point> mPoints;\n"
+             << "};\n"
+             << "\n"
+             << "int Widget" << i << "::sum() const\n"
+             << "{\n"
+             << "    int s = 0;\n"
+             << "    for (const Point &p : mPoints)\n"
+             << "        s += p.x * p.y;\n"
+             << "    return s;\n"
+             << "}\n"
+             << "\n"
+             << "int f" << i << "(const int *p, int n)\n"
+             << "{\n"
+             << "    int buf[10] = {0};\n"
+             << "    int x = " << (i % 7) << ";\n"
+             << "    if (p == nullptr)\n"
+             << "        return -1;\n"
+             << "    for (int j = 0; j < n && j < 10; ++j) {\n"
+             << "        if (j % 2 == 0)\n"
+             << "            buf[j] = p[j] + x;\n"
+             << "        else\n"
+             << "            x += clamp(p[j], 0, 100);\n"
+             << "    }\n"
+             << "    Widget" << i << " w(n);\n"
+             << "    w.add(Point{x, n});\n"
+             << "    switch (x % 3) {\n"
+             << "    case 0:\n"
+             << "        return buf[0] + w.sum();\n"
+             << "    case 1:\n"
+             << "        return buf[1] + (int)w.name().size();\n"
+             << "    default:\n"
+             << "        break;\n"
+             << "    }\n";
+        if (i > 0)
+            code << "    return x + f" << (i - 1) << "(buf, 10);\n";
+        else
+            code << "    return x;\n";
+        code << "}\n"
+             << "\n";
+    }
+    return code.str();
+}
+
+std::string readCorpora(const std::vector<std::string> &files, std::vector<Corpus> &corpora)
+{
+    for (const std::string &file : files) {
+        std::ifstream fin(file);
+        if (!fin.is_open())
+            return "could not open file '" + file + "'";
+        std::ostringstream code;
+        code << fin.rdbuf();
+        corpora.push_back(Corpus{file, file, code.str()});
+    }
+    return "";
+}
@@ -0,0 +1,44 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef corpusH
+#define corpusH
+
+#include <string>
+#include <vector>
+
+/** Code that the benchmarks are run on */
+struct Corpus {
+    /** "generated" or the path of a file */
+    std::string name;
+    /** the file name given to the tokenizer, the language is derived from it */
+    std::string filename;
+    std::string code;
+};
+
+/**
+ * Generate C++ code with classes, templates, loops, conditions and standard
+ * containers. The same size always gives the same code.
+ * @param size number of classes and functions
+ */
+std::string generateCode(int size);
+
+/** Read the files given on the command line, an error message is returned if a file cannot be read */
+std::string readCorpora(const std::vector<std::string> &files, std::vector<Corpus> &corpora);
+
+#endif // corpusH
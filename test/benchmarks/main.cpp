@@ -0,0 +1,462 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Microbenchmarks of the core engines. The benchmarks are run on a generated
+// corpus and on the files given on the command line. The results can be
+// written as JSON to compare them between commits.
+
+#include "check.h"
+#include "color.h"
+#include "corpus.h"
+#include "errorlogger.h"
+#include "errortypes.h"
+#include "json.h"
+#include "library.h"
+#include "preprocessor.h"
+#include "settings.h"
+#include "timer.h"
+#include "token.h"
+#include "tokenize.h"
+#include "tokenlist.h"
+#include "version.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <simplecpp.h>
+
+namespace {
+    class NullErrorLogger : public ErrorLogger {
+    public:
+        void reportOut(const std::string & /*outmsg*/, Color /*c*/ = Color::Reset) override {}
+        void reportErr(const ErrorMessage & /*msg*/) override {}
+    };
+
+    /** Collects the clocks of the Timer phases of a run */
+    class PhaseClocks : public TimerResults {
+    public:
+        void addResults(const std::string& str, std::clock_t clocks) override {
+            mClocks[str] += clocks;
+        }
+
+        std::map<std::string, std::clock_t> mClocks;
+    };
+
+    /** Patterns as they are used by the checkers */
+    const char * const matchPatterns[] = {
+        "%var% =",
+        "%name% (",
+        "if|while|for (",
+        "[;{}] %var% = %num% ;",
+        "return %var% ;",
+        "%var% . %name% (",
+        "!!. %name% (",
+        "%type% * %var%",
+        "%op%|%cop% %var%",
+        "[(,] & %var% [,)]"
+    };
+
+    const char * const simpleMatchPatterns[] = {
+        "if (",
+        ") {",
+        "} else {",
+        "return ;",
+        "for (",
+        "= 0 ;",
+        "std :: vector <",
+        "== nullptr )"
+    };
+
+    /** The checkers whose runChecks() are measured */
+    const char * const checkNames[] = {
+        "Bounds checking",
+        "Condition",
+        "Null pointer",
+        "Other",
+        "STL usage",
+        "Uninitialized variables"
+    };
+
+    struct Result {
+        std::string benchmark;
+        std::string corpus;
+        /** the phases are measured with std::clock(), the rest with a wall clock */
+        bool cpu;
+        std::vector<double> seconds;
+
+        double min() const {
+            return *std::min_element(seconds.cbegin(), seconds.cend());
+        }
+        double median() const {
+            std::vector<double> sorted(seconds);
+            std::sort(sorted.begin(), sorted.end());
+            const std::size_t n = sorted.size();
+            return (n % 2 == 1) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+        }
+        double mean() const {
+            return std::accumulate(seconds.cbegin(), seconds.cend(), 0.0) / static_cast<double>(seconds.size());
+        }
+    };
+
+    template<class F>
+    double elapsed(F f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    class Benchmarks {
+    public:
+        Benchmarks(const Settings &settings, int repeat, std::string filter)
+            : mSettings(settings), mRepeat(repeat), mFilter(std::move(filter))
+        {}
+
+        void run(const Corpus &corpus);
+
+        const std::vector<Result> &results() const {
+            return mResults;
+        }
+
+    private:
+        bool enabled(const std::string &benchmark) const {
+            return mFilter.empty() || benchmark.find(mFilter) != std::string::npos;
+        }
+
+        /** Measure a benchmark. Each call of sample() returns the seconds of one sample. */
+        template<class F>
+        void measure(const std::string &benchmark, const Corpus &corpus, F sample) {
+            if (!enabled(benchmark))
+                return;
+            Result result{benchmark, corpus.name, false, {}};
+            for (int i = 0; i < mRepeat; ++i)
+                result.seconds.push_back(sample());
+            mResults.push_back(std::move(result));
+        }
+
+        std::string configuration(const Corpus &corpus);
+        simplecpp::TokenList preprocess(const Corpus &corpus, const std::string &cfg, std::vector<std::string> &files);
+        std::unique_ptr<Tokenizer> tokenize(const simplecpp::TokenList &tokens);
+
+        void simplifyTokens1(const Corpus &corpus, const simplecpp::TokenList &tokens);
+        void match(const Corpus &corpus, const Tokenizer &tokenizer);
+        void checks(const Corpus &corpus, const Tokenizer &tokenizer);
+
+        const Settings &mSettings;
+        NullErrorLogger mErrorLogger;
+        const int mRepeat;
+        const std::string mFilter;
+        std::vector<Result> mResults;
+        /** keeps the results of Token::Match() alive */
+        std::size_t mMatches{};
+    };
+
+    /** The first configuration of the corpus that can be preprocessed without errors */
+    std::string Benchmarks::configuration(const Corpus &corpus)
+    {
+        std::vector<std::string> files;
+        std::istringstream istr(corpus.code);
+        simplecpp::TokenList tokens1(istr, files, corpus.filename);
+        Preprocessor preprocessor(mSettings, mErrorLogger);
+        preprocessor.loadFiles(tokens1, files);
+        tokens1.removeComments();
+        preprocessor.removeComments();
+        for (const std::string &cfg : preprocessor.getConfigs(tokens1)) {
+            try {
+                (void)preprocess(corpus, cfg, files);
+                return cfg;
+            } catch (const simplecpp::Output &) {}
+        }
+        throw InternalError(nullptr, "no configuration of the corpus could be preprocessed");
+    }
+
+    simplecpp::TokenList Benchmarks::preprocess(const Corpus &corpus, const std::string &cfg, std::vector<std::string> &files)
+    {
+        std::istringstream istr(corpus.code);
+        simplecpp::TokenList tokens1(istr, files, corpus.filename);
+        Preprocessor preprocessor(mSettings, mErrorLogger);
+        preprocessor.loadFiles(tokens1, files);
+        tokens1.removeComments();
+        preprocessor.removeComments();
+        preprocessor.simplifyPragmaAsm(&tokens1);
+        preprocessor.setPlatformInfo(&tokens1);
+        return preprocessor.preprocess(tokens1, cfg, files, true);
+    }
+
+    std::unique_ptr<Tokenizer> Benchmarks::tokenize(const simplecpp::TokenList &tokens)
+    {
+        std::unique_ptr<Tokenizer> tokenizer(new Tokenizer(mSettings, mErrorLogger));
+        simplecpp::TokenList copy(tokens);
+        tokenizer->list.createTokens(std::move(copy));
+        return tokenizer;
+    }
+
+    void Benchmarks::run(const Corpus &corpus)
+    {
+        const std::string cfg = configuration(corpus);
+
+        measure("Preprocessor::preprocess", corpus, [&]() {
+            std::vector<std::string> sampleFiles;
+            return elapsed([&]() {
+                (void)preprocess(corpus, cfg, sampleFiles);
+            });
+        });
+
+        std::vector<std::string> files;
+        const simplecpp::TokenList tokens = preprocess(corpus, cfg, files);
+
+        measure("TokenList::createTokens", corpus, [&]() {
+            Tokenizer tokenizer(mSettings, mErrorLogger);
+            simplecpp::TokenList copy(tokens);
+            return elapsed([&]() {
+                tokenizer.list.createTokens(std::move(copy));
+            });
+        });
+
+        simplifyTokens1(corpus, tokens);
+
+        const std::unique_ptr<Tokenizer> tokenizer = tokenize(tokens);
+        if (!tokenizer->simplifyTokens1(""))
+            throw InternalError(nullptr, "the code of the corpus could not be simplified");
+
+        match(corpus, *tokenizer);
+        checks(corpus, *tokenizer);
+    }
+
+    /** Measure simplifyTokens1() and its phases */
+    void Benchmarks::simplifyTokens1(const Corpus &corpus, const simplecpp::TokenList &tokens)
+    {
+        const std::string benchmark = "Tokenizer::simplifyTokens1";
+        if (!enabled(benchmark))
+            return;
+
+        Settings settings(mSettings);
+        settings.showtime = SHOWTIME_MODES::SHOWTIME_SUMMARY;
+
+        Result total{benchmark, corpus.name, false, {}};
+        std::map<std::string, Result> phases;
+        for (int i = 0; i < mRepeat; ++i) {
+            Tokenizer tokenizer(settings, mErrorLogger);
+            simplecpp::TokenList copy(tokens);
+            tokenizer.list.createTokens(std::move(copy));
+            PhaseClocks clocks;
+            tokenizer.setTimerResults(&clocks);
+            total.seconds.push_back(elapsed([&]() {
+                (void)tokenizer.simplifyTokens1("");
+            }));
+            for (const std::pair<const std::string, std::clock_t> &phase : clocks.mClocks) {
+                // only the phases of the tokenizer, not the ValueFlow passes
+                if (phase.first.compare(0, benchmark.size() + 2, benchmark + "::") != 0)
+                    continue;
+                Result &result = phases[phase.first];
+                result.benchmark = phase.first;
+                result.corpus = corpus.name;
+                result.cpu = true;
+                result.seconds.push_back(static_cast<double>(phase.second) / CLOCKS_PER_SEC);
+            }
+        }
+        mResults.push_back(std::move(total));
+        for (std::pair<const std::string, Result> &phase : phases)
+            mResults.push_back(std::move(phase.second));
+    }
+
+    void Benchmarks::match(const Corpus &corpus, const Tokenizer &tokenizer)
+    {
+        measure("Token::Match", corpus, [&]() {
+            return elapsed([&]() {
+                for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
+                    for (const char *pattern : matchPatterns)
+                        mMatches += Token::Match(tok, pattern) ? 1 : 0;
+                }
+            });
+        });
+
+        measure("Token::simpleMatch", corpus, [&]() {
+            return elapsed([&]() {
+                for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
+                    for (const char *pattern : simpleMatchPatterns)
+                        mMatches += Token::simpleMatch(tok, pattern, std::strlen(pattern)) ? 1 : 0;
+                }
+            });
+        });
+    }
+
+    void Benchmarks::checks(const Corpus &corpus, const Tokenizer &tokenizer)
+    {
+        for (const char *name : checkNames) {
+            const auto it = std::find_if(Check::instances().cbegin(), Check::instances().cend(), [&](const Check *check) {
+                return check->name() == name;
+            });
+            if (it == Check::instances().cend())
+                continue;
+            Check *check = *it;
+            measure(check->name() + "::runChecks", corpus, [&]() {
+                return elapsed([&]() {
+                    check->runChecks(tokenizer, &mErrorLogger);
+                });
+            });
+        }
+    }
+
+    void printResults(const std::vector<Result> &results)
+    {
+        std::size_t width = 0;
+        for (const Result &result : results)
+            width = std::max(width, result.benchmark.size() + result.corpus.size() + 3);
+        std::cout << std::fixed << std::setprecision(3);
+        for (const Result &result : results) {
+            std::cout << std::left << std::setw(static_cast<int>(width)) << (result.benchmark + " [" + result.corpus + "]")
+                      << std::right
+                      << "  min " << std::setw(10) << result.min() * 1000 << " ms"
+                      << "  median " << std::setw(10) << result.median() * 1000 << " ms"
+                      << "  mean " << std::setw(10) << result.mean() * 1000 << " ms"
+                      << (result.cpu ? "  (cpu)" : "") << std::endl;
+        }
+    }
+
+    std::string toJson(const std::vector<Result> &results, int repeat, int size)
+    {
+        picojson::array jsonResults;
+        for (const Result &result : results) {
+            picojson::array samples;
+            for (const double s : result.seconds)
+                samples.emplace_back(s);
+            picojson::object jsonResult;
+            jsonResult["benchmark"] = picojson::value(result.benchmark);
+            jsonResult["corpus"] = picojson::value(result.corpus);
+            jsonResult["clock"] = picojson::value(std::string(result.cpu ? "cpu" : "wall"));
+            jsonResult["min"] = picojson::value(result.min());
+            jsonResult["median"] = picojson::value(result.median());
+            jsonResult["mean"] = picojson::value(result.mean());
+            jsonResult["samples"] = picojson::value(std::move(samples));
+            jsonResults.emplace_back(std::move(jsonResult));
+        }
+        picojson::object root;
+        root["cppcheck"] = picojson::value(std::string(CPPCHECK_VERSION_STRING));
+        root["repeat"] = picojson::value(static_cast<int64_t>(repeat));
+        root["size"] = picojson::value(static_cast<int64_t>(size));
+        root["unit"] = picojson::value(std::string("s"));
+        root["results"] = picojson::value(std::move(jsonResults));
+        return picojson::value(std::move(root)).serialize(true);
+    }
+
+    void printHelp()
+    {
+        std::cout << "Microbenchmarks of the Cppcheck core engines.\n"
+                     "\n"
+                     "Syntax:\n"
+                     "    benchmarks [OPTIONS] [files]\n"
+                     "\n"
+                     "The benchmarks are run on a generated corpus and on the given files.\n"
+                     "\n"
+                     "Options:\n"
+                     "    --filter=<text>  Only run the benchmarks whose name contains the text.\n"
+                     "    --json=<file>    Write the results as JSON to the file.\n"
+                     "    --repeat=<n>     The number of samples of each benchmark (default: 5).\n"
+                     "    --size=<n>       The number of classes and functions in the generated\n"
+                     "                     corpus (default: 200). 0 skips the generated corpus.\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int repeat = 5;
+    int size = 200;
+    std::string filter;
+    std::string jsonFile;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--filter=", 9) == 0)
+            filter = argv[i] + 9;
+        else if (std::strncmp(argv[i], "--json=", 7) == 0)
+            jsonFile = argv[i] + 7;
+        else if (std::strncmp(argv[i], "--repeat=", 9) == 0)
+            repeat = std::atoi(argv[i] + 9);
+        else if (std::strncmp(argv[i], "--size=", 7) == 0)
+            size = std::atoi(argv[i] + 7);
+        else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
+            printHelp();
+            return EXIT_SUCCESS;
+        } else if (argv[i][0] == '-') {
+            std::cerr << "benchmarks: unknown option '" << argv[i] << "'" << std::endl;
+            return EXIT_FAILURE;
+        } else
+            files.emplace_back(argv[i]);
+    }
+    if (repeat < 1 || size < 0) {
+        std::cerr << "benchmarks: --repeat must be greater than 0 and --size must not be negative" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Corpus> corpora;
+    if (size > 0)
+        corpora.push_back(Corpus{"generated", "generated.cpp", generateCode(size)});
+    const std::string err = readCorpora(files, corpora);
+    if (!err.empty()) {
+        std::cerr << "benchmarks: " << err << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Settings settings;
+    settings.severity.enable(Severity::warning);
+    settings.severity.enable(Severity::style);
+    settings.severity.enable(Severity::performance);
+    settings.severity.enable(Severity::portability);
+    if (settings.library.load(argv[0], "std.cfg").errorcode != Library::ErrorCode::OK) {
+        std::cerr << "benchmarks: could not load std.cfg" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Benchmarks benchmarks(settings, repeat, filter);
+    for (const Corpus &corpus : corpora) {
+        try {
+            benchmarks.run(corpus);
+        } catch (const simplecpp::Output &o) {
+            std::cerr << "benchmarks: " << corpus.name << ":" << o.location.line << ": " << o.msg << std::endl;
+            return EXIT_FAILURE;
+        } catch (const InternalError &e) {
+            std::cerr << "benchmarks: " << corpus.name << ": " << e.errorMessage << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    printResults(benchmarks.results());
+
+    if (!jsonFile.empty()) {
+        std::ofstream fout(jsonFile);
+        if (!fout.is_open()) {
+            std::cerr << "benchmarks: could not write '" << jsonFile << "'" << std::endl;
+            return EXIT_FAILURE;
+        }
+        fout << toJson(benchmarks.results(), repeat, size) << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "analysisserver.h"
+#include "color.h"
+#include "errorlogger.h"
+#include "filesettings.h"
+#include "fixture.h"
+#include "helpers.h"
+#include "path.h"
+#include "settings.h"
+
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <string>
+#include <thread>
+
+class TestAnalysisServer : public TestFixture {
+public:
+    TestAnalysisServer() : TestFixture("TestAnalysisServer") {}
+
+private:
+    const Settings settings = settingsBuilder().build();
+
+    class ErrorLogger2 : public ErrorLogger {
+    public:
+        std::string out;
+
+    private:
+        void reportOut(const std::string &outmsg, Color /*c*/ = Color::Reset) override {
+            out += outmsg + '\n';
+        }
+
+        void reportErr(const ErrorMessage & /*msg*/) override {}
+    };
+
+    void run() override {
+#if !defined(WIN32) && !defined(__MINGW32__)
+        TEST_CASE(checkFile);
+        TEST_CASE(checkProjectFile);
+        TEST_CASE(checkContent);
+        TEST_CASE(noServer);
+#endif
+    }
+
+#if !defined(WIN32) && !defined(__MINGW32__)
+    const std::string socketPath = "testanalysisserver.sock";
+
+    /** Start a server in the background, run the client code and shut the server down again */
+    template<class F>
+    void withServer(const std::list<FileSettings> &fileSettings, const F &client) {
+        ErrorLogger2 serverLogger;
+        AnalysisServer server(settings, fileSettings, serverLogger, {});
+        bool started = false;
+        std::thread thread([&]() {
+            started = server.run(socketPath);
+        });
+
+        // wait until the server accepts connections
+        ErrorLogger2 probeLogger;
+        for (int i = 0; i < 500 && AnalysisServer::check(socketPath, {}, probeLogger) < 0; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        try {
+            client();
+        } catch (...) {
+            AnalysisServer::shutdown(socketPath);
+            thread.join();
+            throw;
+        }
+
+        ASSERT(AnalysisServer::shutdown(socketPath));
+        thread.join();
+        ASSERT(started);
+        ASSERT_EQUALS("", serverLogger.out);
+    }
+
+    void checkFile() {
+        const ScopedFile file("analysisserver_file.cpp", "void f() { int a[10]; a[10] = 0; }");
+        withServer({}, [&]() {
+            const std::list<FileWithDetails> files{FileWithDetails(file.path())};
+            ASSERT_EQUALS(1, AnalysisServer::check(socketPath, files, *this));
+            ASSERT_EQUALS("[" + Path::getAbsoluteFilePath(file.path()) + ":1]: (error) Array 'a[10]' accessed at index 10, which is out of bounds.\n", errout_str());
+            ASSERT_EQUALS("Checking " + Path::getAbsoluteFilePath(file.path()) + " ...\n", output_str());
+
+            // the same connection handles any number of files
+            ASSERT_EQUALS(2, AnalysisServer::check(socketPath, {files.front(), files.front()}, *this));
+            ignore_errout();
+            (void)output_str();
+        });
+    }
+
+    void checkProjectFile() {
+        const ScopedFile file("analysisserver_project.cpp", "#ifdef X\nvoid f() { int a[10]; a[10] = 0; }\n#endif\n");
+        std::list<FileSettings> fileSettings;
+        fileSettings.emplace_back(file.path());
+        fileSettings.back().defines = "X";
+        withServer(fileSettings, [&]() {
+            // the project file and its defines are used
+            ASSERT_EQUALS(1, AnalysisServer::check(socketPath, {FileWithDetails(file.path())}, *this));
+            ASSERT_EQUALS("[" + file.path() + ":2]: (error) Array 'a[10]' accessed at index 10, which is out of bounds.\n", errout_str());
+            ASSERT_EQUALS("Checking " + file.path() + " ...\nChecking " + file.path() + ": X...\n", output_str());
+        });
+    }
+
+    void checkContent() {
+        const ScopedFile file("analysisserver_content.cpp", "void f() {}");
+        withServer({}, [&]() {
+            // the content is checked instead of the file on disk
+            ASSERT_EQUALS(1, AnalysisServer::check(socketPath, FileWithDetails(file.path()), "void f() {\n  char *p = 0;\n  *p = 0;\n}\n", *this));
+            ASSERT_EQUALS("[" + Path::getAbsoluteFilePath(file.path()) + ":3]: (error) Null pointer dereference: p\n", errout_str());
+
+            // unsaved files do not exist on disk
+            ASSERT_EQUALS(0, AnalysisServer::check(socketPath, FileWithDetails("analysisserver_unsaved.cpp"), "void f() {}\n", *this));
+            ASSERT_EQUALS("", errout_str());
+            (void)output_str();
+        });
+    }
+
+    void noServer() {
+        std::remove(socketPath.c_str());
+        ASSERT_EQUALS(-1, AnalysisServer::check(socketPath, {FileWithDetails("file.cpp")}, *this));
+        ASSERT_EQUALS(false, AnalysisServer::shutdown(socketPath));
+    }
+#endif
+};
+
+REGISTER_TEST(TestAnalysisServer)
@@ -0,0 +1,150 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "changedlines.h"
+#include "fixture.h"
+
+#include <sstream>
+#include <string>
+
+class TestChangedLines : public TestFixture {
+public:
+    TestChangedLines() : TestFixture("TestChangedLines") {}
+
+private:
+    void run() override {
+        TEST_CASE(gitDiff);
+        TEST_CASE(unifiedDiff);
+        TEST_CASE(newAndRemovedFile);
+        TEST_CASE(hunkContent);
+        TEST_CASE(invalidHunk);
+        TEST_CASE(paths);
+        TEST_CASE(merge);
+    }
+
+    static std::string dump(const ChangedLines &changedLines) {
+        std::ostringstream out;
+        changedLines.dump(out);
+        return out.str();
+    }
+
+    void gitDiff() const {
+        std::istringstream diff("diff --git a/lib/a.cpp b/lib/a.cpp\n"
+                                "index 1234567..89abcde 100644\n"
+                                "--- a/lib/a.cpp\n"
+                                "+++ b/lib/a.cpp\n"
+                                "@@ -10,6 +10,7 @@ void f()\n"
+                                " a;\n"
+                                " b;\n"
+                                "-c;\n"
+                                "+c1;\n"
+                                "+c2;\n"
+                                " d;\n"
+                                "\n"
+                                " e;\n"
+                                "@@ -30,3 +31,2 @@ void g()\n"
+                                " x;\n"
+                                "-y;\n"
+                                " z;\n"
+                                "\\ No newline at end of file\n");
+        ChangedLines changedLines;
+        ASSERT_EQUALS("", changedLines.parseDiff(diff));
+        ASSERT_EQUALS("lib/a.cpp 12-13 32-32\n", dump(changedLines));
+        ASSERT_EQUALS(true, changedLines.isChanged("lib/a.cpp", 13, 13));
+        ASSERT_EQUALS(true, changedLines.isChanged("lib/a.cpp", 1, 12));
+        ASSERT_EQUALS(false, changedLines.isChanged("lib/a.cpp", 14, 31));
+        ASSERT_EQUALS(false, changedLines.isChanged("lib/b.cpp", 13, 13));
+    }
+
+    void unifiedDiff() const {
+        std::istringstream diff("--- old/a.c\t2024-01-01 10:00:00.000000000 +0100\r\n"
+                                "+++ new/a.c\t2024-01-02 10:00:00.000000000 +0100\r\n"
+                                "@@ -1 +1 @@\r\n"
+                                "-int x;\r\n"
+                                "+long x;\r\n");
+        ChangedLines changedLines;
+        ASSERT_EQUALS("", changedLines.parseDiff(diff));
+        ASSERT_EQUALS("new/a.c 1-1\n", dump(changedLines));
+    }
+
+    void newAndRemovedFile() const {
+        std::istringstream diff("--- /dev/null\n"
+                                "+++ b/new.cpp\n"
+                                "@@ -0,0 +1,2 @@\n"
+                                "+int a;\n"
+                                "+int b;\n"
+                                "--- a/old.cpp\n"
+                                "+++ /dev/null\n"
+                                "@@ -1,1 +0,0 @@\n"
+                                "-int c;\n");
+        ChangedLines changedLines;
+        ASSERT_EQUALS("", changedLines.parseDiff(diff));
+        ASSERT_EQUALS("new.cpp 1-2\n", dump(changedLines));
+    }
+
+    void hunkContent() const {
+        // removed and added lines which look like file headers
+        std::istringstream diff("--- a/a.cpp\n"
+                                "+++ b/a.cpp\n"
+                                "@@ -5,2 +5,2 @@\n"
+                                "--- x;\n"
+                                "+++ y;\n"
+                                " z;\n");
+        ChangedLines changedLines;
+        ASSERT_EQUALS("", changedLines.parseDiff(diff));
+        ASSERT_EQUALS("a.cpp 5-5\n", dump(changedLines));
+    }
+
+    void invalidHunk() const {
+        {
+            std::istringstream diff("@@ -1 +1 @@\n");
+            ChangedLines changedLines;
+            ASSERT_EQUALS("hunk without file in diff: '@@ -1 +1 @@'", changedLines.parseDiff(diff));
+        }
+        {
+            std::istringstream diff("--- a/a.cpp\n"
+                                    "+++ b/a.cpp\n"
+                                    "@@ -1 +x @@\n");
+            ChangedLines changedLines;
+            ASSERT_EQUALS("invalid hunk header in diff: '@@ -1 +x @@'", changedLines.parseDiff(diff));
+        }
+    }
+
+    void paths() const {
+        ChangedLines changedLines;
+        changedLines.add("src/./a.cpp", 3, 4);
+        ASSERT_EQUALS(true, changedLines.hasFile("src/a.cpp"));
+        ASSERT_EQUALS(true, changedLines.hasFile("/home/user/project/src/a.cpp"));
+        ASSERT_EQUALS(true, changedLines.hasFile("a.cpp"));
+        ASSERT_EQUALS(false, changedLines.hasFile("xsrc/a.cpp"));
+        ASSERT_EQUALS(false, changedLines.hasFile("src/b.cpp"));
+        ASSERT_EQUALS(true, changedLines.isChanged("/home/user/project/src/a.cpp", 4, 10));
+    }
+
+    void merge() const {
+        ChangedLines changedLines;
+        changedLines.add("a.cpp", 10, 10);
+        changedLines.add("a.cpp", 1, 2);
+        changedLines.add("a.cpp", 5, 6);
+        changedLines.add("a.cpp", 3, 4);
+        changedLines.add("a.cpp", 0, 0);
+        ASSERT_EQUALS("a.cpp 1-6 10-10\n", dump(changedLines));
+    }
+};
+
+REGISTER_TEST(TestChangedLines)
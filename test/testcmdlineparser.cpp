@@ -23,6 +23,7 @@
 #include "errorlogger.h"
 #include "errortypes.h"
 #include "helpers.h"
+#include "memoryusage.h"
 #include "path.h"
 #include "platform.h"
 #include "redirect.h"
@@ -268,12 +269,14 @@ private:
         TEST_CASE(xmlverinvalid);
         TEST_CASE(doc);
         TEST_CASE(docExclusive);
+        TEST_CASE(showmemory);
         TEST_CASE(showtimeSummary);
         TEST_CASE(showtimeFile);
         TEST_CASE(showtimeFileTotal);
         TEST_CASE(showtimeTop5);
         TEST_CASE(showtimeTop5File);
         TEST_CASE(showtimeTop5Summary);
+        TEST_CASE(showtimeCounters);
         TEST_CASE(showtimeNone);
         TEST_CASE(showtimeEmpty);
         TEST_CASE(showtimeInvalid);
@@ -312,6 +315,8 @@ private:
 #endif
         TEST_CASE(maxCtuDepth);
         TEST_CASE(maxCtuDepthInvalid);
+        TEST_CASE(maxMemoryPerFile);
+        TEST_CASE(maxMemoryPerFileInvalid);
         TEST_CASE(performanceValueflowMaxTime);
         TEST_CASE(performanceValueflowMaxTimeInvalid);
         TEST_CASE(performanceValueFlowMaxIfCount);
@@ -392,6 +397,27 @@ private:
         TEST_CASE(cppHeaderProbe2);
         TEST_CASE(noCppHeaderProbe);
         TEST_CASE(noCppHeaderProbe2);
+        TEST_CASE(reduceSuppressedHeaders);
+        TEST_CASE(diff);
+        TEST_CASE(diffStdin);
+        TEST_CASE(diffMissingFile);
+        TEST_CASE(diffInvalid);
+        TEST_CASE(diffEmpty);
+        TEST_CASE(functionCache);
+#if !defined(WIN32) && !defined(__MINGW32__)
+        TEST_CASE(server);
+        TEST_CASE(serverEmpty);
+        TEST_CASE(serverAndSource);
+        TEST_CASE(serverAndClient);
+        TEST_CASE(client);
+        TEST_CASE(clientEmpty);
+        TEST_CASE(lspAndServer);
+#else
+        TEST_CASE(serverNotSupported);
+        TEST_CASE(clientNotSupported);
+#endif
+        TEST_CASE(lsp);
+        TEST_CASE(lspAndSource);
 
         TEST_CASE(ignorepaths1);
         TEST_CASE(ignorepaths2);
@@ -1716,6 +1742,18 @@ private:
         ASSERT(startsWith(logger->str(), "## "));
     }
 
+    void showmemory() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--showmemory", "file.cpp"};
+        if (MemoryUsage::isHooked()) {
+            ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parser->parseFromArgs(3, argv));
+            ASSERT(settings->showmemory);
+        } else {
+            ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(3, argv));
+            ASSERT_EQUALS("cppcheck: error: --showmemory is not supported by this build.\n", logger->str());
+        }
+    }
+
     void showtimeSummary() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--showtime=summary", "file.cpp"};
@@ -1759,6 +1797,13 @@ private:
         ASSERT(settings->showtime == SHOWTIME_MODES::SHOWTIME_TOP5_SUMMARY);
     }
 
+    void showtimeCounters() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--showtime=counters", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parser->parseFromArgs(3, argv));
+        ASSERT(settings->showtime == SHOWTIME_MODES::SHOWTIME_COUNTERS);
+    }
+
     void showtimeNone() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--showtime=none", "file.cpp"};
@@ -1777,7 +1822,7 @@ private:
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--showtime=top10", "file.cpp"};
         ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(3, argv));
-        ASSERT_EQUALS("cppcheck: error: unrecognized --showtime mode: 'top10'. Supported modes: file, file-total, summary, top5, top5_file, top5_summary.\n", logger->str());
+        ASSERT_EQUALS("cppcheck: error: unrecognized --showtime mode: 'top10'. Supported modes: file, file-total, summary, top5, top5_file, top5_summary, counters.\n", logger->str());
     }
 
     void errorlist() {
@@ -2007,6 +2052,20 @@ private:
         ASSERT_EQUALS("cppcheck: error: argument to '--max-ctu-depth=' is not valid - not an integer.\n", logger->str());
     }
 
+    void maxMemoryPerFile() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--max-memory-per-file=2048", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS(2048, settings->maxMemoryPerFile);
+    }
+
+    void maxMemoryPerFileInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--max-memory-per-file=-1", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS("cppcheck: error: argument to '--max-memory-per-file=' needs to be a positive integer.\n", logger->str());
+    }
+
     void performanceValueflowMaxTime() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--performance-valueflow-max-time=12", "file.cpp"};
@@ -2643,6 +2702,151 @@ private:
         ASSERT_EQUALS(false, settings->cppHeaderProbe);
     }
 
+    void reduceSuppressedHeaders() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--reduce-suppressed-headers", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS(true, settings->reduceSuppressedHeaders);
+    }
+
+    void diff() {
+        REDIRECT;
+        ScopedFile file("changes.diff",
+                        "--- a/file.cpp\n"
+                        "+++ b/file.cpp\n"
+                        "@@ -3,0 +4,2 @@\n"
+                        "+int a;\n"
+                        "+int b;\n");
+        const char * const argv[] = {"cppcheck", "--diff=changes.diff", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS(true, settings->diff.isChanged("file.cpp", 5, 5));
+        ASSERT_EQUALS(false, settings->diff.isChanged("file.cpp", 3, 3));
+    }
+
+    void diffStdin() {
+        REDIRECT;
+        RedirectInput input("--- a/file.cpp\n"
+                            "+++ b/file.cpp\n"
+                            "@@ -1 +1 @@\n"
+                            "-int a;\n"
+                            "+int b;\n");
+        const char * const argv[] = {"cppcheck", "--diff=-", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS(true, settings->diff.isChanged("file.cpp", 1, 1));
+    }
+
+    void diffMissingFile() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--diff=changes.diff", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS("cppcheck: error: couldn't open the file: \"changes.diff\".\n", logger->str());
+    }
+
+    void diffInvalid() {
+        REDIRECT;
+        ScopedFile file("changes.diff",
+                        "@@ -1 +1 @@\n");
+        const char * const argv[] = {"cppcheck", "--diff=changes.diff", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS("cppcheck: error: hunk without file in diff: '@@ -1 +1 @@'\n", logger->str());
+    }
+
+    void diffEmpty() {
+        REDIRECT;
+        ScopedFile file("changes.diff", "");
+        const char * const argv[] = {"cppcheck", "--diff=changes.diff", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS("cppcheck: error: no changed lines found in the diff.\n", logger->str());
+    }
+
+    void functionCache() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--function-cache", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS(true, settings->functionCache);
+    }
+
+#if !defined(WIN32) && !defined(__MINGW32__)
+    void server() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--server=/tmp/cppcheck.sock"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parser->parseFromArgs(2, argv));
+        ASSERT_EQUALS("/tmp/cppcheck.sock", settings->serverSocket);
+        ASSERT_EQUALS("", logger->str());
+    }
+
+    void serverEmpty() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--server="};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(2, argv));
+        ASSERT_EQUALS("cppcheck: error: no socket specified for '--server'.\n", logger->str());
+    }
+
+    void serverAndSource() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--server=/tmp/cppcheck.sock", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS("cppcheck: error: '--server' cannot be used in conjunction with source files.\n", logger->str());
+    }
+
+    void serverAndClient() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--server=/tmp/cppcheck.sock", "--client=/tmp/cppcheck.sock"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS("cppcheck: error: '--server' cannot be used in conjunction with '--client'.\n", logger->str());
+    }
+
+    void client() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--client=/tmp/cppcheck.sock", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS("/tmp/cppcheck.sock", settings->clientSocket);
+    }
+
+    void clientEmpty() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--client=", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS("cppcheck: error: no socket specified for '--client'.\n", logger->str());
+    }
+
+    void lspAndServer() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--lsp", "--client=cppcheck.sock"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS("cppcheck: error: '--lsp' cannot be used in conjunction with '--server' or '--client'.\n", logger->str());
+    }
+#else
+    void serverNotSupported() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--server=cppcheck.sock"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(2, argv));
+        ASSERT_EQUALS("cppcheck: error: Option --server is not supported on this platform.\n", logger->str());
+    }
+
+    void clientNotSupported() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--client=cppcheck.sock", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS("cppcheck: error: Option --client is not supported on this platform.\n", logger->str());
+    }
+#endif
+
+    void lsp() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--lsp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parser->parseFromArgs(2, argv));
+        ASSERT_EQUALS(true, settings->lsp);
+        ASSERT_EQUALS("", logger->str());
+    }
+
+    void lspAndSource() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--lsp", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parser->parseFromArgs(3, argv));
+        ASSERT_EQUALS("cppcheck: error: '--lsp' cannot be used in conjunction with source files or projects.\n", logger->str());
+    }
+
     void ignorepaths1() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "-isrc", "file.cpp"};
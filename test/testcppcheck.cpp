@@ -23,12 +23,16 @@
 #include "fixture.h"
 #include "helpers.h"
 #include "settings.h"
+#include "utils.h"
 
 #include "simplecpp.h"
 
 #include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <list>
 #include <string>
+#include <utility>
 
 
 class TestCppcheck : public TestFixture {
@@ -56,6 +60,8 @@ private:
         TEST_CASE(checkWithFile);
         TEST_CASE(checkWithFS);
         TEST_CASE(suppress_error_library);
+        TEST_CASE(diff);
+        TEST_CASE(functionCache);
         TEST_CASE(unique_errors);
         TEST_CASE(isPremiumCodingStandardId);
         TEST_CASE(getDumpFileContentsRawTokens);
@@ -154,6 +160,89 @@ private:
         ASSERT_EQUALS(0, errorLogger.ids.size());
     }
 
+    void diff() const
+    {
+        ScopedFile file("test.cpp",
+                        "void f()\n"
+                        "{\n"
+                        "  int i = *((int*)0);\n"
+                        "}\n"
+                        "void g()\n"
+                        "{\n"
+                        "  int i = *((int*)0);\n"
+                        "}");
+
+        ErrorLogger2 errorLogger;
+        CppCheck cppcheck(errorLogger, false, {});
+        cppcheck.settings().diff.add(file.path(), 7, 7);
+        ASSERT_EQUALS(1, cppcheck.check(FileWithDetails(file.path())));
+        // TODO: how to properly disable these warnings?
+        errorLogger.errmsgs.remove_if([](const ErrorMessage& msg) {
+            return msg.id == "logChecker";
+        });
+        // only the finding in the changed line is reported
+        ASSERT_EQUALS(1, errorLogger.errmsgs.size());
+        ASSERT_EQUALS("nullPointer", errorLogger.errmsgs.front().id);
+        ASSERT_EQUALS(7, errorLogger.errmsgs.front().callStack.back().line);
+    }
+
+    void functionCache() const
+    {
+        ScopedFile analyzerInfo("fc.cpp.analyzerinfo", "", "fc-build");
+        ScopedFile summaries("fc-build/fc.cpp.snalyzerinfo", "");
+        ScopedFile file("fc.cpp",
+                        "void f()\n"
+                        "{\n"
+                        "  int i = *((int*)0);\n"
+                        "}\n"
+                        "void g()\n"
+                        "{\n"
+                        "}");
+
+        const auto check = [&](std::list<ErrorMessage> &errmsgs) {
+            ErrorLogger2 errorLogger;
+            CppCheck cppcheck(errorLogger, false, {});
+            cppcheck.settings().buildDir = "fc-build";
+            cppcheck.settings().functionCache = true;
+            cppcheck.check(FileWithDetails(file.path()));
+            // TODO: how to properly disable these warnings?
+            errorLogger.errmsgs.remove_if([](const ErrorMessage& msg) {
+                return msg.id == "logChecker";
+            });
+            errmsgs = std::move(errorLogger.errmsgs);
+        };
+
+        std::list<ErrorMessage> errmsgs;
+        check(errmsgs);
+        ASSERT_EQUALS(1, errmsgs.size());
+        ASSERT_EQUALS("Null pointer dereference: (int*)0", errmsgs.front().shortMessage());
+
+        // mark the stored finding of f
+        std::string info;
+        {
+            std::ifstream fin(analyzerInfo.path());
+            info.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+        }
+        ASSERT(info.find("<function ") != std::string::npos);
+        findAndReplace(info, "Null pointer dereference", "Cached null pointer dereference");
+        std::ofstream(analyzerInfo.path()) << info;
+
+        // g is changed, f is moved: the finding of f is reused
+        std::ofstream(file.path()) << "\n"
+            "void f()\n"
+            "{\n"
+            "  int i = *((int*)0);\n"
+            "}\n"
+            "void g()\n"
+            "{\n"
+            "  int j = 0;\n"
+            "}";
+        check(errmsgs);
+        ASSERT_EQUALS(1, errmsgs.size());
+        ASSERT_EQUALS("Cached null pointer dereference: (int*)0", errmsgs.front().shortMessage());
+        ASSERT_EQUALS(4, errmsgs.front().callStack.back().line);
+    }
+
     // TODO: hwo to actually get duplicated findings
     void unique_errors() const
     {
@@ -77,6 +77,7 @@ private:
         TEST_CASE(testPrintfParenthesis); // #8489
         TEST_CASE(testStdDistance); // #10304
         TEST_CASE(testParameterPack); // #11289
+        TEST_CASE(testFormatStringReuse);
     }
 
     struct CheckOptions
@@ -4921,6 +4922,23 @@ private:
               "}\n");
         ASSERT_EQUALS("", errout_str());
     }
+
+    void testFormatStringReuse() { // parsed format strings are cached, arguments must be checked per call
+        check("void foo(int i, char *s) {\n"
+              "    printf(\"%d %s\", i, s);\n"
+              "    printf(\"%d %s\", s, i);\n"
+              "    printf(\"%d %s\", i);\n"
+              "    scanf(\"%d %s\", &i, s);\n"
+              "    scanf(\"%d %s\", i, s);\n"
+              "}\n");
+        ASSERT_EQUALS("[test.cpp:3]: (warning) %d in format string (no. 1) requires 'int' but the argument type is 'char *'.\n"
+                      "[test.cpp:3]: (warning) %s in format string (no. 2) requires 'char *' but the argument type is 'signed int'.\n"
+                      "[test.cpp:4]: (error) printf format string requires 2 parameters but only 1 is given.\n"
+                      "[test.cpp:6]: (warning) %d in format string (no. 1) requires 'int *' but the argument type is 'signed int'.\n"
+                      "[test.cpp:5]: (warning) scanf() without field width limits can crash with huge input data.\n"
+                      "[test.cpp:6]: (warning) scanf() without field width limits can crash with huge input data.\n",
+                      errout_str());
+    }
 };
 
 REGISTER_TEST(TestIO)
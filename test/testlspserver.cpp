@@ -0,0 +1,149 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fixture.h"
+#include "helpers.h"
+#include "lspserver.h"
+#include "settings.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+class TestLspServer : public TestFixture {
+public:
+    TestLspServer() : TestFixture("TestLspServer") {}
+
+private:
+    const Settings settings = settingsBuilder().build();
+
+    void run() override {
+        TEST_CASE(initialize);
+        TEST_CASE(unknownRequest);
+        TEST_CASE(diagnostics);
+        TEST_CASE(diagnosticsInclude);
+        TEST_CASE(closeDocument);
+        TEST_CASE(framing);
+        TEST_CASE(exitWithoutShutdown);
+    }
+
+    static std::string frame(const std::string &message) {
+        return "Content-Length: " + std::to_string(message.size()) + "\r\n\r\n" + message;
+    }
+
+    static std::string didOpen(const std::string &uri, const std::string &text) {
+        return "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":{\"uri\":\"" + uri + "\",\"languageId\":\"cpp\",\"version\":1,\"text\":\"" + text + "\"}}}";
+    }
+
+    void initialize() {
+        std::istringstream in;
+        std::ostringstream out;
+        LspServer server(settings, in, out, {});
+        server.handleMessage("{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"initialize\",\"params\":{}}");
+        const std::string response = "{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":{\"capabilities\":{\"textDocumentSync\":{\"change\":1,\"openClose\":true,\"save\":{\"includeText\":false}}},\"serverInfo\":{\"name\":\"cppcheck\",\"version\":\"" + std::string(CppCheck::version()) + "\"}}}";
+        ASSERT_EQUALS(frame(response), out.str());
+        out.str("");
+
+        server.handleMessage("{\"jsonrpc\":\"2.0\",\"id\":\"2\",\"method\":\"shutdown\"}");
+        ASSERT_EQUALS(frame("{\"id\":\"2\",\"jsonrpc\":\"2.0\",\"result\":null}"), out.str());
+    }
+
+    void unknownRequest() {
+        std::istringstream in;
+        std::ostringstream out;
+        LspServer server(settings, in, out, {});
+        server.handleMessage("{\"jsonrpc\":\"2.0\",\"id\":3,\"method\":\"textDocument/hover\",\"params\":{}}");
+        ASSERT_EQUALS(frame("{\"error\":{\"code\":-32601,\"message\":\"unsupported method 'textDocument\\/hover'\"},\"id\":3,\"jsonrpc\":\"2.0\"}"), out.str());
+
+        // notifications are ignored
+        out.str("");
+        server.handleMessage("{\"jsonrpc\":\"2.0\",\"method\":\"$/cancelRequest\",\"params\":{\"id\":3}}");
+        server.handleMessage("no json");
+        ASSERT_EQUALS("", out.str());
+    }
+
+    void diagnostics() {
+        std::istringstream in;
+        std::ostringstream out;
+        LspServer server(settings, in, out, {});
+        server.debounce = std::chrono::milliseconds(0);
+
+        // the unsaved content is analyzed, the file does not exist
+        server.handleMessage(didOpen("file:///lsp/test%20file.cpp", "void f() {\\n  char *p = 0;\\n  *p = 0;\\n}\\n"));
+        server.waitIdle();
+        const std::string diagnostic = "{\"code\":\"nullPointer\",\"message\":\"Null pointer dereference: p\",\"range\":{\"end\":{\"character\":3,\"line\":2},\"start\":{\"character\":3,\"line\":2}},\"severity\":1,\"source\":\"cppcheck\"}";
+        const std::string publish = frame("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"diagnostics\":[" + diagnostic + "],\"uri\":\"file:\\/\\/\\/lsp\\/test%20file.cpp\",\"version\":1}}");
+        // published when found and when the analysis is done
+        ASSERT_EQUALS(publish + publish, out.str());
+        out.str("");
+
+        server.handleMessage("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didChange\",\"params\":{\"textDocument\":{\"uri\":\"file:///lsp/test%20file.cpp\",\"version\":2},\"contentChanges\":[{\"text\":\"void f() {}\\n\"}]}}");
+        server.waitIdle();
+        ASSERT_EQUALS(frame("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"diagnostics\":[],\"uri\":\"file:\\/\\/\\/lsp\\/test%20file.cpp\",\"version\":2}}"), out.str());
+    }
+
+    void diagnosticsInclude() {
+        ScopedFile header("lsp_header.h", "void g() {\n  char *p = 0;\n  *p = 0;\n}\n");
+        std::istringstream in;
+        std::ostringstream out;
+        LspServer server(settings, in, out, {});
+
+        // findings in included files belong to other documents
+        server.handleMessage(didOpen("lsp_main.cpp", "#include \\\"lsp_header.h\\\"\\n"));
+        server.waitIdle();
+        ASSERT_EQUALS(frame("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"diagnostics\":[],\"uri\":\"lsp_main.cpp\",\"version\":1}}"), out.str());
+    }
+
+    void closeDocument() {
+        std::istringstream in;
+        std::ostringstream out;
+        LspServer server(settings, in, out, {});
+        server.debounce = std::chrono::hours(1);
+
+        server.handleMessage(didOpen("file:///lsp/close.cpp", "void f() {}\\n"));
+        server.waitIdle();
+        out.str("");
+
+        // the pending analysis of the change is dropped and the diagnostics are cleared
+        server.handleMessage("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didChange\",\"params\":{\"textDocument\":{\"uri\":\"file:///lsp/close.cpp\",\"version\":2},\"contentChanges\":[{\"text\":\"void f() { int a[2]; a[2] = 0; }\\n\"}]}}");
+        server.handleMessage("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didClose\",\"params\":{\"textDocument\":{\"uri\":\"file:///lsp/close.cpp\"}}}");
+        server.waitIdle();
+        ASSERT_EQUALS(frame("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"diagnostics\":[],\"uri\":\"file:\\/\\/\\/lsp\\/close.cpp\"}}"), out.str());
+    }
+
+    void framing() {
+        std::istringstream in(frame("{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"shutdown\"}") +
+                              "content-length: 33\r\nContent-Type: application/vscode-jsonrpc; charset=utf-8\r\n\r\n{\"jsonrpc\":\"2.0\",\"method\":\"exit\"}" +
+                              frame("{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"shutdown\"}"));
+        std::ostringstream out;
+        LspServer server(settings, in, out, {});
+        ASSERT_EQUALS(EXIT_SUCCESS, server.run());
+        // nothing is read after exit
+        ASSERT_EQUALS(frame("{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":null}"), out.str());
+    }
+
+    void exitWithoutShutdown() {
+        std::istringstream in(frame("{\"jsonrpc\":\"2.0\",\"method\":\"exit\"}"));
+        std::ostringstream out;
+        LspServer server(settings, in, out, {});
+        ASSERT_EQUALS(EXIT_FAILURE, server.run());
+    }
+};
+
+REGISTER_TEST(TestLspServer)
@@ -0,0 +1,101 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2023 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "errortypes.h"
+#include "fixture.h"
+#include "memoryusage.h"
+
+#include <string>
+
+class TestMemoryUsage : public TestFixture {
+public:
+    TestMemoryUsage() : TestFixture("TestMemoryUsage") {}
+
+private:
+
+    void run() override {
+        TEST_CASE(phases);
+        TEST_CASE(limit);
+        TEST_CASE(serialize);
+        TEST_CASE(deserializeInvalid);
+    }
+
+    void phases() const {
+        MemoryUsage::startFile();
+        MemoryUsage::allocated(1000);
+        const MemoryUsage::Phase outer = MemoryUsage::startPhase();
+        MemoryUsage::allocated(5000);
+        MemoryUsage::deallocated(5000);
+        const MemoryUsage::Phase inner = MemoryUsage::startPhase();
+        MemoryUsage::allocated(2000);
+        MemoryUsage::stopPhase("inner", inner);
+        MemoryUsage::stopPhase("outer", outer);
+        MemoryUsage::deallocated(3000);
+        const MemoryUsage::FileResults results = MemoryUsage::stopFile("file.cpp");
+
+        ASSERT_EQUALS("file.cpp", results.file);
+        ASSERT_EQUALS(6000, results.peak);
+        ASSERT_EQUALS(2U, results.phases.size());
+        ASSERT_EQUALS("inner", results.phases[0].first);
+        ASSERT_EQUALS(2000, results.phases[0].second);
+        ASSERT_EQUALS("outer", results.phases[1].first);
+        ASSERT_EQUALS(5000, results.phases[1].second);
+    }
+
+    void limit() const {
+        MemoryUsage::startFile(1000);
+        MemoryUsage::allocated(600);
+        ASSERT(!MemoryUsage::limitExceeded());
+        MemoryUsage::allocated(600);
+        ASSERT(MemoryUsage::limitExceeded());
+        MemoryUsage::deallocated(1200);
+        ASSERT(MemoryUsage::limitExceeded());
+        (void)MemoryUsage::stopFile("file.cpp");
+        ASSERT(!MemoryUsage::limitExceeded());
+
+        MemoryUsage::startFile();
+        MemoryUsage::allocated(2000);
+        ASSERT(!MemoryUsage::limitExceeded());
+        MemoryUsage::deallocated(2000);
+        (void)MemoryUsage::stopFile("file.cpp");
+    }
+
+    void serialize() const {
+        MemoryUsage::FileResults results;
+        results.file = "dir/file 1.cpp";
+        results.peak = 3 * 1024 * 1024;
+        results.phases.emplace_back("Tokenizer::simplifyTokens1", 2 * 1024 * 1024);
+        results.phases.emplace_back("Check::runChecks", 1024 * 1024);
+
+        MemoryUsage::FileResults copy;
+        copy.deserialize(results.serialize());
+        ASSERT_EQUALS(results.file, copy.file);
+        ASSERT_EQUALS(results.peak, copy.peak);
+        ASSERT(results.phases == copy.phases);
+        ASSERT_EQUALS("Memory usage: dir/file 1.cpp: 3.0 MiB\n"
+                      "  Tokenizer::simplifyTokens1: +2.0 MiB", copy.toString(1));
+    }
+
+    void deserializeInvalid() const {
+        MemoryUsage::FileResults results;
+        ASSERT_THROW_INTERNAL_EQUALS(results.deserialize(""), INTERNAL, "Internal Error: Deserialization of memory usage failed - no data");
+        ASSERT_THROW_INTERNAL_EQUALS(results.deserialize("12 file.cpp\nx phase\n"), INTERNAL, "Internal Error: Deserialization of memory usage failed - invalid line 'x phase'");
+    }
+};
+
+REGISTER_TEST(TestMemoryUsage)
@@ -94,6 +94,7 @@ private:
         TEST_CASE(suppressingSyntaxErrorAndExitCodeMultiFileFiles);
         TEST_CASE(suppressingSyntaxErrorAndExitCodeMultiFileFS);
         TEST_CASE(suppressLocal);
+        TEST_CASE(suppressFile);
 
         TEST_CASE(suppressUnmatchedSuppressions);
 
@@ -1392,6 +1393,17 @@ private:
         ASSERT_EQUALS(false, suppressions.isSuppressed(errorMessage("errorid2", "test2.cpp", 1), false));
     }
 
+    void suppressFile() const {
+        SuppressionList suppressions;
+        std::istringstream s("*:include/*\n"
+                             "errorid:test.h\n"
+                             "*:test.cpp:3");
+        ASSERT_EQUALS("", suppressions.parseFile(s));
+        ASSERT_EQUALS(true, suppressions.isSuppressedFile("include/a.h"));
+        ASSERT_EQUALS(false, suppressions.isSuppressedFile("test.h"));
+        ASSERT_EQUALS(false, suppressions.isSuppressedFile("test.cpp"));
+    }
+
     void suppressUnmatchedSuppressions() {
         std::list<SuppressionList::Suppression> suppressions;
 
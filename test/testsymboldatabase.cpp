@@ -135,7 +135,7 @@ private:
     }
 
     static const Scope *findFunctionScopeByToken(const SymbolDatabase * db, const Token *tok) {
-        std::list<Scope>::const_iterator scope;
+        StableVector<Scope>::const_iterator scope;
 
         for (scope = db->scopeList.cbegin(); scope != db->scopeList.cend(); ++scope) {
             if (scope->type == Scope::eFunction) {
@@ -590,6 +590,8 @@ private:
 
         TEST_CASE(incomplete_type); // #9255 (infinite recursion)
         TEST_CASE(exprIds);
+        TEST_CASE(hasVarIdBetween);
+        TEST_CASE(varMap);
     }
 
     void array() {
@@ -2496,7 +2498,7 @@ private:
 
         ASSERT(db && db->scopeList.size() == 1);
 
-        const std::list<Scope>::const_iterator it = db->scopeList.cbegin();
+        const StableVector<Scope>::const_iterator it = db->scopeList.cbegin();
         ASSERT(it->varlist.size() == 1);
         const std::list<Variable>::const_iterator var = it->varlist.cbegin();
         ASSERT(var->name() == "i");
@@ -2508,7 +2510,7 @@ private:
 
         ASSERT(db && db->scopeList.size() == 1);
 
-        const std::list<Scope>::const_iterator it = db->scopeList.cbegin();
+        const StableVector<Scope>::const_iterator it = db->scopeList.cbegin();
         ASSERT(it->varlist.size() == 1);
 
         const std::list<Variable>::const_iterator var = it->varlist.cbegin();
@@ -2521,7 +2523,7 @@ private:
 
         ASSERT(db && db->scopeList.size() == 1);
 
-        const std::list<Scope>::const_iterator it = db->scopeList.cbegin();
+        const StableVector<Scope>::const_iterator it = db->scopeList.cbegin();
         ASSERT(it->varlist.size() == 1);
 
         const std::list<Variable>::const_iterator var = it->varlist.cbegin();
@@ -5614,9 +5616,7 @@ private:
         ASSERT(db);
         ASSERT_EQUALS(9, db->scopeList.size());
         ASSERT_EQUALS(1, db->scopeList.front().varlist.size());
-        auto list = db->scopeList;
-        list.pop_front();
-        ASSERT_EQUALS(true, std::all_of(list.cbegin(), list.cend(), [](const Scope& scope) {
+        ASSERT_EQUALS(true, std::all_of(std::next(db->scopeList.cbegin()), db->scopeList.cend(), [](const Scope& scope) {
             return scope.varlist.empty();
         }));
     }
@@ -10659,6 +10659,42 @@ private:
             ASSERT_EQUALS(true, testExprIdNotEqual(code, "(", 3U, "(", 4U));
         }
     }
+
+    void hasVarIdBetween() {
+        GET_SYMBOL_DB("void f() {\n"
+                      "    int x = 1;\n"
+                      "    int y = 2;\n"
+                      "    x = y;\n"
+                      "}\n");
+        const Token *x = Token::findsimplematch(tokenizer.tokens(), "x =");
+        const Token *y = Token::findsimplematch(tokenizer.tokens(), "y =");
+        const Token *assign = Token::findsimplematch(tokenizer.tokens(), "x = y");
+        ASSERT(x && y && assign);
+        const std::set<nonneg int> xId = { x->varId() };
+        const std::set<nonneg int> yId = { y->varId() };
+        ASSERT_EQUALS(true, db->hasVarIdBetween(xId, x, nullptr));
+        ASSERT_EQUALS(true, db->hasVarIdBetween(xId, x->next(), nullptr));
+        ASSERT_EQUALS(false, db->hasVarIdBetween(xId, x->next(), assign));
+        ASSERT_EQUALS(false, db->hasVarIdBetween(xId, assign->next(), nullptr));
+        ASSERT_EQUALS(true, db->hasVarIdBetween(yId, assign->next(), nullptr));
+        ASSERT_EQUALS(false, db->hasVarIdBetween(yId, assign->tokAt(3), nullptr));
+    }
+
+    void varMap() {
+        GET_SYMBOL_DB("extern int x;\n"
+                      "int x;\n"
+                      "int y;\n"
+                      "void f() { int x; }\n");
+        const Scope &global = db->scopeList.front();
+        ASSERT_EQUALS(3, global.varMap.size());
+        ASSERT_EQUALS(2, global.varMap.count("x"));
+        const Variable *x = global.getVariable("x");
+        ASSERT(x);
+        ASSERT_EQUALS(1, x->nameToken()->linenr());
+        const Scope &function = db->scopeList.back();
+        ASSERT_EQUALS(1, function.varMap.size());
+        ASSERT_EQUALS(4, function.getVariable("x")->nameToken()->linenr());
+    }
 };
 
 REGISTER_TEST(TestSymbolDatabase)
@@ -30,6 +30,7 @@ private:
 
     void run() override {
         TEST_CASE(result);
+        TEST_CASE(counters);
     }
 
     void result() const {
@@ -40,6 +41,31 @@ private:
         t1.mClocks = CLOCKS_PER_SEC * 5 / 2;
         ASSERT(std::fabs(t1.seconds()-2.5) < 0.01);
     }
+
+    void counters() const {
+        TimerCounters c1;
+        c1.instructions = 100;
+        c1.cycles = 50;
+        TimerCounters c2;
+        c2.instructions = 40;
+        c2.branchMisses = 3;
+        c1 -= c2;
+        ASSERT_EQUALS(60, c1.instructions);
+        ASSERT_EQUALS(50, c1.cycles);
+        c1 += c2;
+        ASSERT_EQUALS(100, c1.instructions);
+        ASSERT_EQUALS(3, c1.branchMisses);
+
+        // the counters are either available or there is a reason why not
+        TimerCounters c3;
+        if (TimerCounters::read(c3)) {
+            TimerCounters c4;
+            ASSERT(TimerCounters::read(c4));
+            ASSERT(c4.instructions >= c3.instructions);
+        } else {
+            ASSERT(!TimerCounters::unavailableReason().empty());
+        }
+    }
 };
 
 REGISTER_TEST(TestTimer)
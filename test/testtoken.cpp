@@ -94,6 +94,7 @@ private:
         TEST_CASE(operators);
 
         TEST_CASE(updateProperties);
+        TEST_CASE(numberValue);
         TEST_CASE(isNameGuarantees1);
         TEST_CASE(isNameGuarantees2);
         TEST_CASE(isNameGuarantees3);
@@ -1059,6 +1060,32 @@ private:
         ASSERT_EQUALS(true, tok.isNumber());
     }
 
+    void numberValue() const {
+        TokensFrontBack tokensFrontBack(list);
+        Token tok(tokensFrontBack);
+        tok.str("0x10");
+        ASSERT_EQUALS(true, tok.isIntNumber());
+        ASSERT_EQUALS(false, tok.isFloatNumber());
+        ASSERT_EQUALS(16, tok.getIntNumber());
+        ASSERT_EQUALS(16, tok.getIntNumber());
+
+        // cached value is dropped when the token string changes
+        tok.str("1.5f");
+        ASSERT_EQUALS(false, tok.isIntNumber());
+        ASSERT_EQUALS(true, tok.isFloatNumber());
+        ASSERT_EQUALS_DOUBLE(1.5, tok.getFloatNumber(), 1e-9);
+        ASSERT_EQUALS(1, tok.getIntNumber());
+
+        tok.str("123abc");
+        ASSERT_EQUALS(false, tok.isIntNumber());
+        ASSERT_THROW_INTERNAL(tok.getIntNumber(), INTERNAL);
+        ASSERT_THROW_INTERNAL(tok.getIntNumber(), INTERNAL);
+
+        tok.str("foo");
+        ASSERT_EQUALS(false, tok.isIntNumber());
+        ASSERT_EQUALS(false, tok.isFloatNumber());
+    }
+
     void isNameGuarantees1() const {
         TokensFrontBack tokensFrontBack(list);
         Token tok(tokensFrontBack);
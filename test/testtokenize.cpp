@@ -434,6 +434,9 @@ private:
         TEST_CASE(cppcast);
 
         TEST_CASE(checkHeader1);
+        TEST_CASE(checkHeader2);
+        TEST_CASE(removeUnchangedFunctionBodies);
+        TEST_CASE(knownFunctionResults);
 
         TEST_CASE(removeExtraTemplateKeywords);
 
@@ -7835,6 +7838,128 @@ private:
                       checkHdrs(code, false));
     }
 
+    void checkHeader2() { // --reduce-suppressed-headers
+        const char code[] = "# 1 \"test.h\"\n"
+                            "int f() { return 1; }\n"
+                            "int g() { return 2; }\n"
+                            "# 4 \"test.cpp\"\n"
+                            "int h() { return f(); }\n";
+
+        Settings settings;
+        settings.reduceSuppressedHeaders = true;
+        ASSERT_EQUALS("", settings.supprs.nomsg.addSuppressionLine("*:test.h"));
+
+        std::vector<std::string> files(1, "test.cpp");
+        Tokenizer tokenizer(settings, *this);
+        PreprocessorHelper::preprocess(code, files, tokenizer, *this);
+        ASSERT(tokenizer.simplifyTokens1(""));
+
+        // body of g is removed, f is used in test.cpp
+        ASSERT_EQUALS("\n\n##file 1\n"
+                      "1: int f ( ) { return 1 ; }\n"
+                      "2: int g ( ) ;\n"
+                      "\n##file 0\n\n"
+                      "1:\n"
+                      "2:\n"
+                      "3:\n"
+                      "4: int h ( ) { return f ( ) ; }\n",
+                      tokenizer.tokens()->stringifyList());
+    }
+
+    void removeUnchangedFunctionBodies() { // --diff
+        const char code[] = "int callee() { return 1; }\n"
+                            "int other() { return 2; }\n"
+                            "int changed() {\n"
+                            "  return callee();\n"
+                            "}\n"
+                            "struct S {\n"
+                            "  S() : x(0) {}\n"
+                            "  int caller() const { return changed(); }\n"
+                            "  int member() const { return x; }\n"
+                            "  int x;\n"
+                            "};\n";
+
+        Settings settings;
+        settings.diff.add("test.cpp", 4, 4);
+
+        std::vector<std::string> files(1, "test.cpp");
+        Tokenizer tokenizer(settings, *this);
+        PreprocessorHelper::preprocess(code, files, tokenizer, *this);
+        ASSERT(tokenizer.simplifyTokens1(""));
+
+        // bodies of other and member are removed, the constructor is kept
+        ASSERT_EQUALS("\n\n##file 0\n"
+                      "1: int callee ( ) { return 1 ; }\n"
+                      "2: int other ( ) ;\n"
+                      "3: int changed ( ) {\n"
+                      "4: return callee ( ) ;\n"
+                      "5: }\n"
+                      "6: struct S {\n"
+                      "7: S ( ) : x ( 0 ) { }\n"
+                      "8: int caller ( ) const { return changed ( ) ; }\n"
+                      "9: int member ( ) const ;\n"
+                      "10: int x ;\n"
+                      "11: } ;\n",
+                      tokenizer.tokens()->stringifyList());
+    }
+
+    void functionBodies(const char code[], std::string &tokens, std::vector<Tokenizer::FunctionBody> &bodies) {
+        const Settings settings;
+        std::vector<std::string> files(1, "test.cpp");
+        Tokenizer tokenizer(settings, *this);
+        tokenizer.setKnownFunctionResults([](const Tokenizer::FunctionBody &body) {
+            return body.first != 1;
+        });
+        PreprocessorHelper::preprocess(code, files, tokenizer, *this);
+        ASSERT(tokenizer.simplifyTokens1(""));
+        tokens = tokenizer.tokens()->stringifyList();
+        bodies = tokenizer.functionBodies();
+    }
+
+    void knownFunctionResults() { // --function-cache
+        const char code1[] = "int callee() { return 1; }\n"
+                             "int caller() { return callee(); }\n"
+                             "int other() { return 2; }\n"
+                             "struct S {\n"
+                             "  int member() const { return 3; }\n"
+                             "};\n";
+        std::string tokens;
+        std::vector<Tokenizer::FunctionBody> bodies1;
+        functionBodies(code1, tokens, bodies1);
+
+        // the results of callee are not known, its caller is kept. Bodies in classes are kept.
+        ASSERT_EQUALS("\n\n##file 0\n"
+                      "1: int callee ( ) { return 1 ; }\n"
+                      "2: int caller ( ) { return callee ( ) ; }\n"
+                      "3: int other ( ) ;\n"
+                      "4: struct S {\n"
+                      "5: int member ( ) const { return 3 ; }\n"
+                      "6: } ;\n",
+                      tokens);
+        ASSERT_EQUALS(3, bodies1.size());
+        ASSERT_EQUALS(false, bodies1[0].removed);
+        ASSERT_EQUALS(false, bodies1[1].removed);
+        ASSERT_EQUALS(true, bodies1[2].removed);
+        ASSERT_EQUALS("test.cpp", bodies1[2].file);
+        ASSERT_EQUALS(3, bodies1[2].first);
+        ASSERT_EQUALS(3, bodies1[2].last);
+
+        // the hash depends on the code of the callers and callees but not on the lines
+        const char code2[] = "int callee() { return 0; }\n"
+                             "int caller() { return callee(); }\n"
+                             "\n"
+                             "int other()\n"
+                             "{ return 2; }\n";
+        std::vector<Tokenizer::FunctionBody> bodies2;
+        functionBodies(code2, tokens, bodies2);
+        ASSERT_EQUALS(3, bodies2.size());
+        ASSERT(bodies1[0].hash != bodies2[0].hash);
+        ASSERT(bodies1[1].hash != bodies2[1].hash);
+        ASSERT_EQUALS(bodies1[2].hash, bodies2[2].hash);
+        ASSERT_EQUALS(4, bodies2[2].first);
+        ASSERT_EQUALS(5, bodies2[2].last);
+    }
+
     void removeExtraTemplateKeywords() {
         const char code1[] = "typename GridView::template Codim<0>::Iterator iterator;";
         const char expected1[] = "GridView :: Codim < 0 > :: Iterator iterator ;";
@@ -45,6 +45,7 @@ private:
         TEST_CASE(testaddtoken2);
         TEST_CASE(inc);
         TEST_CASE(isKeyword);
+        TEST_CASE(nameCount);
         TEST_CASE(notokens);
         TEST_CASE(ast1);
     }
@@ -153,6 +154,31 @@ private:
         }
     }
 
+    void nameCount() const {
+        const char code[] = "typedef int t; typedef t u; goto x;";
+        TokenList tokenlist(&settings);
+        std::istringstream istr(code);
+        ASSERT(tokenlist.createTokens(istr, "a.cpp"));
+        ASSERT_EQUALS(2, tokenlist.nameCount("typedef"));
+        ASSERT_EQUALS(1, tokenlist.nameCount("goto"));
+        ASSERT_EQUALS(0, tokenlist.nameCount("asm"));
+
+        tokenlist.front()->str("asm");
+        ASSERT_EQUALS(1, tokenlist.nameCount("typedef"));
+        ASSERT_EQUALS(1, tokenlist.nameCount("asm"));
+
+        tokenlist.front()->insertToken("typedef");
+        ASSERT_EQUALS(2, tokenlist.nameCount("typedef"));
+
+        // deleteThis() moves the next token into this one
+        tokenlist.front()->deleteThis();
+        ASSERT_EQUALS(2, tokenlist.nameCount("typedef"));
+        ASSERT_EQUALS(0, tokenlist.nameCount("asm"));
+
+        tokenlist.deallocateTokens();
+        ASSERT_EQUALS(0, tokenlist.nameCount("typedef"));
+    }
+
     void notokens() {
         // analyzing /usr/include/poll.h caused Path::identify() to be called with an empty filename from
         // TokenList::determineCppC() because there are no tokens
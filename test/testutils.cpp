@@ -17,6 +17,7 @@
  */
 
 #include "fixture.h"
+#include "stablevector.h"
 #include "utils.h"
 
 #include <cstddef>
@@ -40,6 +41,8 @@ private:
         TEST_CASE(startsWith);
         TEST_CASE(trim);
         TEST_CASE(findAndReplace);
+        TEST_CASE(stableHash);
+        TEST_CASE(stableVector);
     }
 
     void isValidGlobPattern() const {
@@ -427,6 +430,61 @@ private:
             ASSERT_EQUALS("", s);
         }
     }
+
+    void stableHash() const {
+        // the digest is stored in the build dir so it must never change
+        ASSERT_EQUALS(17241709254077376921ULL, StableHash().digest());
+        ASSERT_EQUALS(14453499434712358580ULL, StableHash().update("abc", 3).digest());
+
+        // streaming in pieces gives the same digest
+        const std::string s = "int main() { return 0; }";
+        StableHash h1;
+        h1.update(s.data(), s.size());
+        StableHash h2;
+        h2.update(s.data(), 5).update(s.data() + 5, s.size() - 5);
+        ASSERT_EQUALS(h1.digest(), h2.digest());
+
+        // strings are length prefixed
+        ASSERT(StableHash().update(std::string("ab")).update(std::string("c")).digest() !=
+               StableHash().update(std::string("a")).update(std::string("bc")).digest());
+        ASSERT(StableHash().update(1).digest() != StableHash().update(2).digest());
+    }
+
+    void stableVector() const {
+        StableVector<std::string> v;
+        ASSERT(v.empty());
+        ASSERT(v.begin() == v.end());
+
+        v.emplace_back("0");
+        const std::string *first = &v.front();
+        for (int i = 1; i < 100; ++i)
+            v.push_back(std::to_string(i));
+        ASSERT_EQUALS(100, v.size());
+        ASSERT(first == &v.front()); // elements are never moved
+        ASSERT_EQUALS("99", v.back());
+        ASSERT_EQUALS("42", v[42]);
+        ASSERT_EQUALS("42", *(v.cbegin() + 42));
+        ASSERT_EQUALS("98", *(--(--v.end())));
+        ASSERT_EQUALS(100, v.cend() - v.cbegin());
+
+        int n = 0;
+        for (const std::string &s : v)
+            ASSERT_EQUALS(std::to_string(n++), s);
+        ASSERT_EQUALS(100, n);
+
+        // like std::list, elements appended during iteration are visited
+        n = 0;
+        for (const std::string &s : v) {
+            if (s == "99")
+                v.emplace_back("100");
+            ++n;
+        }
+        ASSERT_EQUALS(101, n);
+
+        v.pop_back();
+        ASSERT_EQUALS(100, v.size());
+        ASSERT_EQUALS("99", v.back());
+    }
 };
 
 REGISTER_TEST(TestUtils)
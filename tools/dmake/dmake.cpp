@@ -468,6 +468,7 @@ int main(int argc, char **argv)
     libfiles_h.emplace_back("json.h");
     libfiles_h.emplace_back("precompiled.h");
     libfiles_h.emplace_back("smallvector.h");
+    libfiles_h.emplace_back("stablevector.h");
     libfiles_h.emplace_back("standards.h");
     libfiles_h.emplace_back("tokenrange.h");
     libfiles_h.emplace_back("valueptr.h");
@@ -479,7 +480,7 @@ int main(int argc, char **argv)
     std::vector<std::string> clifiles_h;
     for (const std::string &clifile : clifiles) {
         std::string fname(clifile.substr(4));
-        if (fname == "main.cpp")
+        if (fname == "main.cpp" || fname == "memoryhook.cpp")
             continue;
         fname.erase(fname.find(".cpp"));
         clifiles_h.emplace_back(fname + ".h");
@@ -751,7 +752,7 @@ int main(int argc, char **argv)
 
     makeConditionalVariable(fout, "PREFIX", "/usr");
     makeConditionalVariable(fout, "INCLUDE_FOR_LIB", "-Ilib -isystem externals -isystem externals/picojson -isystem externals/simplecpp -isystem externals/tinyxml2");
-    makeConditionalVariable(fout, "INCLUDE_FOR_CLI", "-Ilib -isystem externals/simplecpp -isystem externals/tinyxml2");
+    makeConditionalVariable(fout, "INCLUDE_FOR_CLI", "-Ilib -isystem externals/picojson -isystem externals/simplecpp -isystem externals/tinyxml2");
     makeConditionalVariable(fout, "INCLUDE_FOR_TEST", "-Ilib -Icli -isystem externals/simplecpp -isystem externals/tinyxml2");
 
     fout << "BIN=$(DESTDIR)$(PREFIX)/bin\n\n";
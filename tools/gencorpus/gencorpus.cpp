@@ -0,0 +1,300 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2024 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Generates C/C++ code that stresses a specific part of Cppcheck. The size
+// parameter scales the code so the run time and memory usage of Cppcheck
+// can be compared between sizes, see tools/scaling.py.
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    /** A generated source file */
+    struct File {
+        std::string name;
+        std::string code;
+    };
+
+    /** Deep if/else ladder, the ValueFlow analysis of the branches is limited by maxIfCount */
+    std::vector<File> ifLadder(int size)
+    {
+        std::ostringstream code;
+        code << "int f(int x, int *p)\n"
+             << "{\n"
+             << "    int y = 0;\n";
+        for (int i = 0; i < size; ++i) {
+            code << "    " << (i == 0 ? "" : "else ") << "if (x == " << i << ")\n"
+                 << "        y = p[" << (i % 10) << "] + " << i << ";\n";
+        }
+        code << "    else\n"
+             << "        y = -1;\n"
+             << "    if (y > " << size << ")\n"
+             << "        return p[y];\n"
+             << "    return y;\n"
+             << "}\n";
+        return {{"ifladder.c", code.str()}};
+    }
+
+    /** Large initializer lists */
+    std::vector<File> initList(int size)
+    {
+        std::ostringstream code;
+        code << "#include <vector>\n"
+             << "\n"
+             << "static const int table[] = {";
+        for (int i = 0; i < size; ++i)
+            code << (i % 16 == 0 ? "\n    " : " ") << (i * 7919) % 65536 << ",";
+        code << "\n};\n"
+             << "\n"
+             << "struct Entry {\n"
+             << "    int key;\n"
+             << "    const char *name;\n"
+             << "};\n"
+             << "\n"
+             << "static const Entry entries[] = {\n";
+        for (int i = 0; i < size; ++i)
+            code << "    { " << i << ", \"entry" << i << "\" },\n";
+        code << "};\n"
+             << "\n"
+             << "std::vector<int> values()\n"
+             << "{\n"
+             << "    std::vector<int> v{";
+        for (int i = 0; i < size; ++i)
+            code << (i == 0 ? "" : ", ") << i;
+        code << "};\n"
+             << "    v.push_back(table[" << size - 1 << "] + entries[0].key);\n"
+             << "    return v;\n"
+             << "}\n";
+        return {{"initlist.cpp", code.str()}};
+    }
+
+    /** Recursive templates, each level is instantiated by the template simplifier */
+    std::vector<File> templates(int size)
+    {
+        std::ostringstream code;
+        code << "template<int N>\n"
+             << "struct Sum {\n"
+             << "    static int value() { return N + Sum<N - 1>::value(); }\n"
+             << "};\n"
+             << "\n"
+             << "template<>\n"
+             << "struct Sum<0> {\n"
+             << "    static int value() { return 0; }\n"
+             << "};\n"
+             << "\n"
+             << "template<class T, int N>\n"
+             << "struct Holder {\n"
+             << "    T data[N];\n"
+             << "    T get(int i) const { return data[i]; }\n"
+             << "};\n"
+             << "\n";
+        for (int i = 0; i < size; ++i) {
+            code << "int f" << i << "()\n"
+                 << "{\n"
+                 << "    Holder<int, " << i + 1 << "> h{};\n"
+                 << "    return h.get(" << i << ") + Sum<" << i % 64 << ">::value();\n"
+                 << "}\n";
+        }
+        return {{"templates.cpp", code.str()}};
+    }
+
+    /** Many typedefs, each based on the previous one */
+    std::vector<File> typedefs(int size)
+    {
+        std::ostringstream code;
+        code << "typedef int type0;\n";
+        for (int i = 1; i < size; ++i) {
+            if (i % 3 == 0)
+                code << "typedef struct { type" << i - 1 << " a; type" << i - 1 << " *b; } type" << i << ";\n";
+            else
+                code << "typedef type" << i - 1 << " type" << i << ";\n";
+        }
+        code << "\n";
+        for (int i = 0; i < size; i += 3) {
+            code << "type" << i << " g" << i << "(type" << i << " *p)\n"
+                 << "{\n"
+                 << "    type" << i << " v = *p;\n"
+                 << "    return v;\n"
+                 << "}\n";
+        }
+        return {{"typedefs.c", code.str()}};
+    }
+
+    /** A header with many macros that expand each other, and many #ifdef configurations */
+    std::vector<File> macros(int size)
+    {
+        std::ostringstream header;
+        header << "#ifndef MACROS_H\n"
+               << "#define MACROS_H\n"
+               << "\n"
+               << "#define M0(x) ((x) + 1)\n";
+        for (int i = 1; i < size; ++i)
+            header << "#define M" << i << "(x) M" << i - 1 << "((x) * 2)\n";
+        for (int i = 0; i < size; i += 16) {
+            header << "#ifdef FEATURE" << i << "\n"
+                   << "#define VALUE" << i << " M" << i << "(" << i << ")\n"
+                   << "#else\n"
+                   << "#define VALUE" << i << " " << i << "\n"
+                   << "#endif\n";
+        }
+        header << "\n"
+               << "#endif\n";
+
+        std::ostringstream code;
+        code << "#include \"macros.h\"\n"
+             << "\n"
+             << "int f(int x)\n"
+             << "{\n"
+             << "    int y = M" << size - 1 << "(x);\n";
+        for (int i = 0; i < size; i += 16)
+            code << "    y += VALUE" << i << ";\n";
+        code << "    return y;\n"
+             << "}\n";
+        return {{"macros.h", header.str()}, {"macros.c", code.str()}};
+    }
+
+    /** One long function with many local variables */
+    std::vector<File> locals(int size)
+    {
+        std::ostringstream code;
+        code << "int f(const int *p, int n)\n"
+             << "{\n";
+        for (int i = 0; i < size; ++i)
+            code << "    int v" << i << " = " << (i == 0 ? "n" : "v" + std::to_string(i - 1) + " + p[" + std::to_string(i % 10) + "]") << ";\n";
+        for (int i = 0; i < size; ++i) {
+            code << "    if (v" << i << " > " << i << ")\n"
+                 << "        v" << (size - 1 - i) << " -= v" << i << ";\n";
+        }
+        code << "    return v" << size - 1 << ";\n"
+             << "}\n";
+        return {{"locals.c", code.str()}};
+    }
+
+    /** Many small translation units */
+    std::vector<File> manyFiles(int size)
+    {
+        std::vector<File> files;
+        files.push_back({"common.h", "#ifndef COMMON_H\n"
+                                     "#define COMMON_H\n"
+                                     "struct S {\n"
+                                     "    int a;\n"
+                                     "    int b[4];\n"
+                                     "};\n"
+                                     "int common(const struct S *s);\n"
+                                     "#endif\n"});
+        for (int i = 0; i < size; ++i) {
+            std::ostringstream code;
+            code << "#include \"common.h\"\n"
+                 << "\n"
+                 << "int file" << i << "(struct S *s, int i)\n"
+                 << "{\n"
+                 << "    if (i < 0 || i >= 4)\n"
+                 << "        return common(s);\n"
+                 << "    s->b[i] = " << i << ";\n"
+                 << "    return s->a + s->b[i];\n"
+                 << "}\n";
+            files.push_back({"file" + std::to_string(i) + ".c", code.str()});
+        }
+        return files;
+    }
+
+    struct Kind {
+        const char *name;
+        const char *description;
+        std::function<std::vector<File>(int)> generate;
+    };
+
+    const Kind kinds[] = {
+        {"ifladder", "if/else ladder with <size> branches", ifLadder},
+        {"initlist", "initializer lists with <size> elements", initList},
+        {"templates", "<size> instantiations of recursive templates", templates},
+        {"typedefs", "<size> typedefs based on each other", typedefs},
+        {"macros", "header with <size> nested macros", macros},
+        {"locals", "function with <size> local variables", locals},
+        {"manyfiles", "<size> small translation units", manyFiles}
+    };
+
+    void printHelp()
+    {
+        std::cout << "Generate C/C++ code that stresses a part of Cppcheck.\n"
+                     "\n"
+                     "Syntax:\n"
+                     "    gencorpus --kind=<kind> --size=<n> --output=<dir>\n"
+                     "\n"
+                     "The files are written to the existing directory <dir>. The kinds are:\n";
+        for (const Kind &kind : kinds)
+            std::cout << "    " << kind.name << std::string(12 - std::strlen(kind.name), ' ') << kind.description << '\n';
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string kindName;
+    int size = 0;
+    std::string output;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--kind=", 7) == 0)
+            kindName = argv[i] + 7;
+        else if (std::strncmp(argv[i], "--size=", 7) == 0)
+            size = std::atoi(argv[i] + 7);
+        else if (std::strncmp(argv[i], "--output=", 9) == 0)
+            output = argv[i] + 9;
+        else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
+            printHelp();
+            return EXIT_SUCCESS;
+        } else {
+            std::cerr << "gencorpus: unknown option '" << argv[i] << "'" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    const Kind *kind = nullptr;
+    for (const Kind &k : kinds) {
+        if (kindName == k.name)
+            kind = &k;
+    }
+    if (!kind) {
+        std::cerr << "gencorpus: unknown kind '" << kindName << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (size < 1) {
+        std::cerr << "gencorpus: the size must be greater than 0" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (output.empty()) {
+        std::cerr << "gencorpus: no output directory" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    for (const File &file : kind->generate(size)) {
+        const std::string path = output + '/' + file.name;
+        std::ofstream fout(path);
+        if (!fout.is_open()) {
+            std::cerr << "gencorpus: could not write '" << path << "'" << std::endl;
+            return EXIT_FAILURE;
+        }
+        fout << file.code;
+    }
+    return EXIT_SUCCESS;
+}
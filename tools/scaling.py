@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+
+# Run Cppcheck on generated corpora of increasing size and report how the
+# time and the peak RSS grow with the size. The corpora are generated by
+# tools/gencorpus, each kind stresses another part of Cppcheck.
+
+import argparse
+import json
+import math
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+# the sizes of each kind, the largest runs for a few seconds
+SIZES = {
+    'ifladder': [10, 20, 30, 40],
+    'initlist': [500, 1000, 2000, 4000],
+    'templates': [100, 200, 400, 800],
+    'typedefs': [250, 500, 1000, 2000],
+    'macros': [50, 100, 150, 200],
+    'locals': [25, 50, 75, 100],
+    'manyfiles': [250, 500, 1000, 2000]
+}
+
+# differences below these are too noisy to judge the growth
+MIN_SECONDS = 0.1
+MIN_RSS = 4 * 1024 * 1024
+
+
+def run_cppcheck(cppcheck, args, path):
+    """Return the wall time in seconds and the peak RSS in bytes (None if unknown)"""
+    cmd = [cppcheck, '-q'] + args + [path]
+    start = time.perf_counter()
+    p = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    if hasattr(os, 'wait4'):
+        _, status, usage = os.wait4(p.pid, 0)
+        p.returncode = os.waitstatus_to_exitcode(status) if hasattr(os, 'waitstatus_to_exitcode') else status
+        # ru_maxrss is in bytes on macOS and in KiB elsewhere
+        rss = usage.ru_maxrss if sys.platform == 'darwin' else usage.ru_maxrss * 1024
+    else:
+        p.wait()
+        rss = None
+    seconds = time.perf_counter() - start
+    if p.returncode != 0:
+        raise RuntimeError('{} failed with exit code {}'.format(' '.join(cmd), p.returncode))
+    return seconds, rss
+
+
+def exponent(points, min_value):
+    """The largest growth exponent k of value ~ size^k between two consecutive sizes"""
+    ret = None
+    for (n1, v1), (n2, v2) in zip(points, points[1:]):
+        if v1 < min_value or v2 < min_value:
+            continue
+        k = math.log(v2 / v1) / math.log(n2 / n1)
+        if ret is None or k > ret:
+            ret = k
+    return ret
+
+
+def format_exponent(k):
+    return 'N/A' if k is None else '{:.2f}'.format(k)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Report the scaling of Cppcheck on generated corpora')
+    parser.add_argument('--cppcheck', required=True, help='Path to the Cppcheck binary')
+    parser.add_argument('--gencorpus', required=True, help='Path to the gencorpus binary')
+    parser.add_argument('--kinds', nargs='+', default=list(SIZES), choices=list(SIZES), help='The kinds of corpora')
+    parser.add_argument('--sizes', nargs='+', type=int, help='The sizes of all kinds, instead of the defaults of each kind')
+    parser.add_argument('--cppcheck-args', default='', help='Additional arguments for Cppcheck')
+    parser.add_argument('--max-exponent', default=1.5, type=float,
+                        help='Fail if the time or the RSS grows faster than size^max-exponent (default: 1.5)')
+    parser.add_argument('--reference', help='The results of an earlier run (--json). Only fail if the growth of a kind is '
+                                            'larger than in the reference by more than --tolerance.')
+    parser.add_argument('--tolerance', default=0.25, type=float, help='The tolerance of --reference (default: 0.25)')
+    parser.add_argument('--json', help='Write the results to this file')
+    args = parser.parse_args()
+
+    reference = {}
+    if args.reference:
+        with open(args.reference, 'rt') as f:
+            for result in json.load(f)['results']:
+                reference[result['kind']] = result
+
+    cppcheck_args = args.cppcheck_args.split()
+    work_path = tempfile.mkdtemp(prefix='cppcheck-scaling-')
+    results = []
+    failures = []
+    try:
+        # the startup time (loading the configuration) is not part of the growth
+        empty = os.path.join(work_path, 'empty.c')
+        with open(empty, 'wt') as f:
+            f.write('\n')
+        baseline = min((run_cppcheck(args.cppcheck, cppcheck_args, empty) for _ in range(3)), key=lambda r: r[0])
+        baseline_seconds = baseline[0]
+        baseline_rss = baseline[1]
+
+        print('{:<10} {:>8} {:>10} {:>10}'.format('kind', 'size', 'time [s]', 'RSS [MiB]'))
+        for kind in args.kinds:
+            times = []
+            rss = []
+            for size in args.sizes or SIZES[kind]:
+                corpus_path = os.path.join(work_path, '{}-{}'.format(kind, size))
+                os.mkdir(corpus_path)
+                subprocess.check_call([args.gencorpus, '--kind=' + kind, '--size=' + str(size), '--output=' + corpus_path])
+                seconds, max_rss = run_cppcheck(args.cppcheck, cppcheck_args, corpus_path)
+                shutil.rmtree(corpus_path)
+                seconds = max(seconds - baseline_seconds, 0.0)
+                times.append((size, seconds))
+                # the table shows the peak RSS, the growth is judged above the baseline
+                if max_rss is not None:
+                    rss.append((size, max(max_rss - baseline_rss, 0)))
+                print('{:<10} {:>8} {:>10.3f} {:>10}'.format(kind, size, seconds,
+                                                             'N/A' if max_rss is None else '{:.1f}'.format(max_rss / (1024 * 1024))),
+                      flush=True)
+
+            time_exponent = exponent(times, MIN_SECONDS)
+            rss_exponent = exponent(rss, MIN_RSS)
+            print('{:<10} time ~ size^{}, RSS ~ size^{}'.format(kind, format_exponent(time_exponent), format_exponent(rss_exponent)))
+            for name, k in (('time', time_exponent), ('rss', rss_exponent)):
+                if k is None:
+                    continue
+                limit = args.max_exponent
+                if kind in reference and reference[kind][name + '_exponent'] is not None:
+                    limit = max(limit, reference[kind][name + '_exponent'] + args.tolerance)
+                if k > limit:
+                    failures.append('{}: the {} grows with size^{:.2f}, the limit is size^{:.2f}'.format(kind, name, k, limit))
+            results.append({'kind': kind,
+                            'time': times,
+                            'rss': rss,
+                            'time_exponent': time_exponent,
+                            'rss_exponent': rss_exponent})
+    finally:
+        shutil.rmtree(work_path)
+
+    if args.json:
+        with open(args.json, 'wt') as f:
+            json.dump({'baseline_seconds': baseline_seconds, 'baseline_rss': baseline_rss, 'max_exponent': args.max_exponent, 'results': results}, f, indent=4)
+
+    for failure in failures:
+        print('Super-linear growth: ' + failure)
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())